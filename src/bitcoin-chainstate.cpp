@@ -17,6 +17,7 @@
 #include <kernel/context.h>
 #include <kernel/validation_cache_sizes.h>
 
+#include <blsct/wallet/verification.h>
 #include <consensus/validation.h>
 #include <core_io.h>
 #include <node/blockstorage.h>
@@ -67,6 +68,7 @@ int main(int argc, char* argv[])
     kernel::ValidationCacheSizes validation_cache_sizes{};
     Assert(InitSignatureCache(validation_cache_sizes.signature_cache_bytes));
     Assert(InitScriptExecutionCache(validation_cache_sizes.script_execution_cache_bytes));
+    Assert(blsct::InitRangeProofCache(DEFAULT_MAX_RANGE_PROOF_CACHE_BYTES));
 
 
     // SETUP: Scheduling and Background Signals
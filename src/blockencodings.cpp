@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <blockencodings.h>
+#include <blsct/wallet/txfactory_global.h>
 #include <chainparams.h>
 #include <common/system.h>
 #include <consensus/consensus.h>
@@ -17,12 +18,19 @@
 
 #include <unordered_map>
 
-CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block) :
+CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block, bool blsct_components) :
         nonce(GetRand<uint64_t>()),
         shorttxids(block.vtx.size() - 1), prefilledtxn(1), header(block) {
     FillShortTxIDSelector();
     //TODO: Use our mempool prior to block acceptance to predictively fill more than just the coinbase
     prefilledtxn[0] = {0, block.vtx[0]};
+    if (blsct_components && block.vtx.size() == 2 && block.vtx[0]->IsBLSCT() && !block.vBLSCTComponents.empty()) {
+        shorttxids.resize(block.vBLSCTComponents.size());
+        for (size_t i = 0; i < block.vBLSCTComponents.size(); i++) {
+            shorttxids[i] = GetShortID(block.vBLSCTComponents[i]->GetWitnessHash());
+        }
+        return;
+    }
     for (size_t i = 1; i < block.vtx.size(); i++) {
         const CTransaction& tx = *block.vtx[i];
         shorttxids[i - 1] = GetShortID(tx.GetWitnessHash());
@@ -47,7 +55,7 @@ uint64_t CBlockHeaderAndShortTxIDs::GetShortID(const uint256& txhash) const {
 
 
 
-ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<std::pair<uint256, CTransactionRef>>& extra_txn) {
+ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<std::pair<uint256, CTransactionRef>>& extra_txn, bool blsct_components) {
     if (cmpctblock.header.IsNull() || (cmpctblock.shorttxids.empty() && cmpctblock.prefilledtxn.empty()))
         return READ_STATUS_INVALID;
     if (cmpctblock.shorttxids.size() + cmpctblock.prefilledtxn.size() > MAX_BLOCK_WEIGHT / MIN_SERIALIZABLE_TRANSACTION_WEIGHT)
@@ -76,6 +84,11 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     }
     prefilled_count = cmpctblock.prefilledtxn.size();
 
+    // A BLSCT block has at most one transaction after the coinbase, which
+    // aggregates all the others. Its short ids are the ones of the aggregated
+    // transactions, which can be found in our mempool and aggregated again.
+    aggregated = blsct_components && txn_available.size() > 1 && txn_available[0] && txn_available[0]->IsBLSCT() && cmpctblock.prefilledtxn.size() == 1;
+
     // Calculate map of txids -> positions and check mempool to see what we have (or don't)
     // Because well-formed cmpctblock messages will have a (relatively) uniform distribution
     // of short IDs, any highly-uneven distribution of elements can be safely treated as a
@@ -174,6 +187,10 @@ bool PartiallyDownloadedBlock::IsTxAvailable(size_t index) const
     if (header.IsNull()) return false;
 
     assert(index < txn_available.size());
+    if (aggregated && index > 0) {
+        // Only the aggregated transaction itself can be requested, at index 1
+        return index > 1 || std::all_of(txn_available.begin() + 1, txn_available.end(), [](const auto& tx) { return tx != nullptr; });
+    }
     return txn_available[index] != nullptr;
 }
 
@@ -183,16 +200,30 @@ ReadStatus PartiallyDownloadedBlock::FillBlock(CBlock& block, const std::vector<
 
     uint256 hash = header.GetHash();
     block = header;
-    block.vtx.resize(txn_available.size());
 
     size_t tx_missing_offset = 0;
-    for (size_t i = 0; i < txn_available.size(); i++) {
-        if (!txn_available[i]) {
-            if (vtx_missing.size() <= tx_missing_offset)
+    if (aggregated) {
+        block.vtx.resize(2);
+        block.vtx[0] = std::move(txn_available[0]);
+        if (IsTxAvailable(1)) {
+            std::vector<CTransactionRef> components(txn_available.begin() + 1, txn_available.end());
+            block.vtx[1] = blsct::AggregateTransactions(components, /*fCutThrough=*/true);
+            block.vBLSCTComponents = std::move(components);
+        } else {
+            if (vtx_missing.empty())
                 return READ_STATUS_INVALID;
-            block.vtx[i] = vtx_missing[tx_missing_offset++];
-        } else
-            block.vtx[i] = std::move(txn_available[i]);
+            block.vtx[1] = vtx_missing[tx_missing_offset++];
+        }
+    } else {
+        block.vtx.resize(txn_available.size());
+        for (size_t i = 0; i < txn_available.size(); i++) {
+            if (!txn_available[i]) {
+                if (vtx_missing.size() <= tx_missing_offset)
+                    return READ_STATUS_INVALID;
+                block.vtx[i] = vtx_missing[tx_missing_offset++];
+            } else
+                block.vtx[i] = std::move(txn_available[i]);
+        }
     }
 
     // Make sure we can't call FillBlock again.
@@ -203,7 +234,9 @@ ReadStatus PartiallyDownloadedBlock::FillBlock(CBlock& block, const std::vector<
         return READ_STATUS_INVALID;
 
     BlockValidationState state;
-    CheckBlockFn check_block = m_check_block_mock ? m_check_block_mock : CheckBlock;
+    CheckBlockFn check_block = m_check_block_mock ? m_check_block_mock : [](const CBlock& block, BlockValidationState& state, const Consensus::Params& params, bool fCheckPOW, bool fCheckMerkleRoot) {
+        return CheckBlock(block, state, params, fCheckPOW, fCheckMerkleRoot);
+    };
     if (!check_block(block, state, Params().GetConsensus(), /*fCheckPoW=*/true, /*fCheckMerkleRoot=*/true)) {
         // TODO: We really want to just check merkle tree manually here,
         // but that is expensive, and CheckBlock caches a block's
@@ -109,7 +109,11 @@ public:
     // Dummy for deserialization
     CBlockHeaderAndShortTxIDs() {}
 
-    CBlockHeaderAndShortTxIDs(const CBlock& block);
+    /** With blsct_components, for BLSCT blocks whose aggregated transactions
+      * are known, the short ids are the ones of those transactions instead of
+      * the aggregated one, so that receivers can aggregate them again from
+      * their mempool. Only peers which negotiated this encoding understand it. */
+    explicit CBlockHeaderAndShortTxIDs(const CBlock& block, bool blsct_components = false);
 
     uint64_t GetShortID(const uint256& txhash) const;
 
@@ -131,6 +135,9 @@ class PartiallyDownloadedBlock {
 protected:
     std::vector<CTransactionRef> txn_available;
     size_t prefilled_count = 0, mempool_count = 0, extra_count = 0;
+    // Whether the short ids are the ones of the transactions aggregated into
+    // the second transaction of a BLSCT block, see CBlockHeaderAndShortTxIDs
+    bool aggregated = false;
     const CTxMemPool* pool;
 public:
     CBlockHeader header;
@@ -142,7 +149,8 @@ public:
     explicit PartiallyDownloadedBlock(CTxMemPool* poolIn) : pool(poolIn) {}
 
     // extra_txn is a list of extra transactions to look at, in <witness hash, reference> form
-    ReadStatus InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<std::pair<uint256, CTransactionRef>>& extra_txn);
+    // blsct_components is set if the peer may send the short ids of the transactions aggregated into a BLSCT block
+    ReadStatus InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<std::pair<uint256, CTransactionRef>>& extra_txn, bool blsct_components = false);
     bool IsTxAvailable(size_t index) const;
     ReadStatus FillBlock(CBlock& block, const std::vector<CTransactionRef>& vtx_missing);
 };
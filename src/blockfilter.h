@@ -20,6 +20,7 @@
 
 class CBlock;
 class CBlockUndo;
+class MclG1Point;
 
 /**
  * This implements a Golomb-coded set as defined in BIP 158. It is a
@@ -92,6 +93,7 @@ constexpr uint32_t BASIC_FILTER_M = 784931;
 enum class BlockFilterType : uint8_t
 {
     BASIC = 0,
+    BLSCT = 1,
     INVALID = 255,
 };
 
@@ -107,6 +109,17 @@ const std::set<BlockFilterType>& AllBlockFilterTypes();
 /** Get a comma-separated list of known filter type names. */
 const std::string& ListBlockFilterTypes();
 
+/**
+ * Element of a BLSCT filter for a spent output with the given value commitment.
+ *
+ * BLSCT filters only serve the spend side: a wallet matches the commitments
+ * of the coins it owns to find the blocks spending them. Nothing about a new
+ * BLSCT output can be computed by its recipient before seeing the output,
+ * since its view tag and spending key are derived from its blinding key, so
+ * incoming outputs are found through the view tags instead.
+ */
+GCSFilter::Element BLSCTSpendFilterElement(const MclG1Point& commitment);
+
 /**
  * Complete block filter struct as defined in BIP 157. Serialization matches
  * payload of "cfilter" messages.
@@ -5,6 +5,7 @@
 #include <blsct/arith/mcl/mcl_g1point.h>
 #include <streams.h>
 
+#include <ios>
 #include <numeric>
 
 MclG1Point::MclG1Point()
@@ -165,7 +166,12 @@ MclG1Point MclG1Point::Rand()
 
 bool MclG1Point::IsValid() const
 {
-    return mclBnG1_isValid(&m_point) == 1;
+    return mclBnG1_isValid(&m_point) == 1 && IsValidOrder();
+}
+
+bool MclG1Point::IsValidOrder() const
+{
+    return mclBnG1_isValidOrder(&m_point) == 1;
 }
 
 bool MclG1Point::IsZero() const
@@ -185,16 +191,56 @@ std::vector<uint8_t> MclG1Point::GetVch() const
 
 bool MclG1Point::SetVch(const std::vector<uint8_t>& b)
 {
-    // auto g = GetBasePoint();
-    // auto x = GetBasePoint().GetVch();
-    // if (mclBnG1_deserialize(&m_point, &x[0], x.size()) == 0) {
-    if (mclBnG1_deserialize(&m_point, &b[0], b.size()) == 0) {
+    return SetVch(Span<const uint8_t>{b});
+}
+
+bool MclG1Point::SetVch(Span<const uint8_t> b)
+{
+    // The subgroup check is disabled in mcl by MclInit, so that it can be
+    // either done here or deferred to a later batch
+    if (b.empty() || mclBnG1_deserialize(&m_point, b.data(), b.size()) == 0) {
+        mclBnG1_clear(&m_point);
+        return false;
+    }
+    if (auto deferred = DeferredOrderChecks::Current()) {
+        if (deferred->collect) deferred->points.push_back(*this);
+        return true;
+    }
+    if (!IsValidOrder()) {
         mclBnG1_clear(&m_point);
         return false;
     }
     return true;
 }
 
+void MclG1Point::UnserializeVch(Span<const uint8_t> b)
+{
+    if (SetVch(b)) return;
+    // SetVch() cleared the point. Tell a point outside the subgroup apart
+    // from an encoding which is not on the curve, which is read as zero.
+    Underlying point;
+    if (mclBnG1_deserialize(&point, b.data(), b.size()) != 0) {
+        throw std::ios_base::failure("G1 point not in the prime order subgroup");
+    }
+}
+
+static thread_local MclG1Point::DeferredOrderChecks* g_deferred_order_checks{nullptr};
+
+MclG1Point::DeferredOrderChecks::DeferredOrderChecks(bool collect_points) : collect(collect_points), m_prev(g_deferred_order_checks)
+{
+    g_deferred_order_checks = this;
+}
+
+MclG1Point::DeferredOrderChecks::~DeferredOrderChecks()
+{
+    g_deferred_order_checks = m_prev;
+}
+
+MclG1Point::DeferredOrderChecks* MclG1Point::DeferredOrderChecks::Current()
+{
+    return g_deferred_order_checks;
+}
+
 std::string MclG1Point::GetString(const uint8_t& radix) const
 {
     char str[1024];
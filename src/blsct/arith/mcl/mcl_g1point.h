@@ -10,8 +10,10 @@
 #include <bls/bls384_256.h>
 #include <blsct/arith/endianness.h>
 #include <blsct/arith/mcl/mcl_scalar.h>
+#include <span.h>
 #include <uint256.h>
 
+#include <array>
 #include <stddef.h>
 #include <string>
 #include <vector>
@@ -55,10 +57,12 @@ public:
     static MclG1Point Rand();
 
     bool IsValid() const;
+    bool IsValidOrder() const;
     bool IsZero() const;
 
     std::vector<uint8_t> GetVch() const;
     bool SetVch(const std::vector<uint8_t>& vec);
+    bool SetVch(Span<const uint8_t> vec);
 
     std::string GetString(const uint8_t& radix = 16) const;
     void SetString(const std::string& hex);
@@ -75,14 +79,49 @@ public:
     template <typename Stream>
     void Unserialize(Stream& s)
     {
-        std::vector<unsigned char> vec(SERIALIZATION_SIZE);
-        s.read(MakeWritableByteSpan(vec));
-        SetVch(vec);
+        std::array<uint8_t, SERIALIZATION_SIZE> buf;
+        s.read(MakeWritableByteSpan(buf));
+        UnserializeVch(Span<const uint8_t>{buf});
     }
 
+    /**
+     * While an instance of this class is alive, points deserialized on the
+     * current thread skip the subgroup check. A copy of each such point is
+     * collected instead so that the checks can be run later as one batch
+     * with IsValidOrder(). With collect set to false the points are not
+     * collected and the checks are skipped altogether, which is only meant
+     * for data that passed the checks before it was stored. Instances can
+     * be nested; the innermost one applies.
+     */
+    class DeferredOrderChecks
+    {
+    public:
+        explicit DeferredOrderChecks(bool collect = true);
+        ~DeferredOrderChecks();
+
+        DeferredOrderChecks(const DeferredOrderChecks&) = delete;
+        DeferredOrderChecks& operator=(const DeferredOrderChecks&) = delete;
+
+        static DeferredOrderChecks* Current();
+
+        const bool collect;
+        std::vector<MclG1Point> points;
+
+    private:
+        DeferredOrderChecks* m_prev;
+    };
+
     Underlying m_point;
 
     static constexpr int SERIALIZATION_SIZE = 384 / 8;
+
+private:
+    /**
+     * Like SetVch(), but a point on the curve which is not in the prime order
+     * subgroup makes deserialization fail instead of being read as zero, so
+     * that transactions are rejected for it like the blocks in CheckBlock().
+     */
+    void UnserializeVch(Span<const uint8_t> b);
 };
 
 #endif // NAVIO_BLSCT_ARITH_MCL_MCL_G1POINT_H
\ No newline at end of file
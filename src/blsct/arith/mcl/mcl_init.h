@@ -39,6 +39,9 @@ public:
             throw std::runtime_error("blsInit failed");
         }
         mclBn_setETHserialization(1);
+        // G1 subgroup checks are done by MclG1Point itself so that they
+        // can be deferred and batched when deserializing blocks
+        mclBn_verifyOrderG1(0);
 
         is_initialized = true;
     }
@@ -78,6 +78,10 @@ bool GetLastStakeModifier(const CBlockIndex* pindex, uint64_t& nStakeModifier, i
     AssertLockHeld(::cs_main);
     if (!pindex)
         return false; // error("GetLastStakeModifier: null pindex");
+    // Connected blocks know the last block that generated a modifier, and
+    // the ancestors of a block are connected before it
+    if ((pindex->nStatus & BLOCK_STAKE_MODIFIER_SET) && pindex->pindexStakeModifier)
+        pindex = pindex->pindexStakeModifier;
     while (pindex && pindex->pprev && !pindex->GeneratedStakeModifier())
         pindex = pindex->pprev;
     if (!pindex->GeneratedStakeModifier()) {
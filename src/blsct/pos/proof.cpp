@@ -119,4 +119,17 @@ uint256 ProofOfStake::CalculateMinValue(const uint256& kernel_hash, const unsign
     if (next_target == 0) return uint256();
     return ArithToUint256(UintToArith256(kernel_hash) / arith_uint256().SetCompact(next_target));
 }
+
+Point ProofOfStake::CalculatePhi(const blsct::Message& eta_phi, const Scalar& m, const Scalar& f)
+{
+    auto gens = SetMemProofSetup<Arith>::Get().Gf().GetInstance(eta_phi);
+
+    return gens.H * f + gens.G * m;
+}
+
+bool ProofOfStake::IsKernelEligible(const Scalar& m, const uint256& kernel_hash, const unsigned int& next_target)
+{
+    // the range proof is built against the lower 64 bits of the minimum value
+    return m.GetUint64() >= CalculateMinValue(kernel_hash, next_target).GetUint64(0);
+}
 } // namespace blsct
\ No newline at end of file
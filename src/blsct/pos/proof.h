@@ -68,6 +68,11 @@ public:
 
     static uint256 CalculateMinValue(const uint256& kernel_hash, const unsigned int& next_target);
 
+    // Set element image of the commitment (m, f), as the set membership proof computes it
+    static Point CalculatePhi(const blsct::Message& eta_phi, const Scalar& m, const Scalar& f);
+    // Whether a commitment of value m can prove the kernel hash, without building the proof
+    static bool IsKernelEligible(const Scalar& m, const uint256& kernel_hash, const unsigned int& next_target);
+
     template <typename Stream>
     void Serialize(Stream& s) const
     {
@@ -16,7 +16,11 @@ using Prover = SetMemProofProver<Arith>;
 namespace blsct {
 ProofOfStake ProofOfStakeLogic::Create(const CCoinsViewCache& cache, const Scalar& m, const Scalar& f, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params)
 {
-    auto staked_commitments = cache.GetStakedCommitments().GetElements();
+    return Create(cache.GetStakedCommitments().GetElements(), m, f, pindexPrev, block, params);
+}
+
+ProofOfStake ProofOfStakeLogic::Create(const Points& staked_commitments, const Scalar& m, const Scalar& f, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params)
+{
     auto eta_fiat_shamir = blsct::CalculateSetMemProofRandomness(pindexPrev);
     auto eta_phi = blsct::CalculateSetMemProofGeneratorSeed(pindexPrev);
 
@@ -29,8 +33,11 @@ ProofOfStake ProofOfStakeLogic::Create(const CCoinsViewCache& cache, const Scala
 
 bool ProofOfStakeLogic::Verify(const CCoinsViewCache& cache, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params)
 {
-    auto staked_commitments = cache.GetStakedCommitments().GetElements();
+    return Verify(cache.GetStakedCommitments().GetElements(), pindexPrev, block, params);
+}
 
+bool ProofOfStakeLogic::Verify(const Points& staked_commitments, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params)
+{
     if (staked_commitments.Size() < 2) {
         LogPrint(BCLog::POPS, "PoPS rejected. Staked commitments size is %d\n", staked_commitments.Size());
         return false;
@@ -50,4 +57,15 @@ bool ProofOfStakeLogic::Verify(const CCoinsViewCache& cache, const CBlockIndex*
 
     return res == blsct::ProofOfStake::VerificationResult::VALID;
 }
+
+bool ProofOfStakeLogic::IsKernelEligible(const Scalar& m, const Scalar& f, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params)
+{
+    auto eta_phi = blsct::CalculateSetMemProofGeneratorSeed(pindexPrev);
+    auto phi = ProofOfStake::CalculatePhi(eta_phi, m, f);
+
+    auto kernel_hash = blsct::CalculateKernelHash(pindexPrev->nTime, pindexPrev->nStakeModifier, phi, block.nTime);
+    auto next_target = blsct::GetNextTargetRequired(pindexPrev, &block, params);
+
+    return ProofOfStake::IsKernelEligible(m, kernel_hash, next_target);
+}
 } // namespace blsct
\ No newline at end of file
@@ -25,7 +25,10 @@ public:
     ProofOfStakeLogic(const blsct::ProofOfStake& proof) : blsct::ProofOfStake(proof){};
 
     static ProofOfStake Create(const CCoinsViewCache& cache, const Scalar& m, const Scalar& f, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params);
+    static ProofOfStake Create(const Points& staked_commitments, const Scalar& m, const Scalar& f, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params);
     static bool Verify(const CCoinsViewCache& cache, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params);
+    static bool Verify(const Points& staked_commitments, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params);
+    static bool IsKernelEligible(const Scalar& m, const Scalar& f, const CBlockIndex* pindexPrev, const CBlock& block, const Consensus::Params& params);
 };
 } // namespace blsct
 
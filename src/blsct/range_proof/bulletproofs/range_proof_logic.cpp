@@ -386,14 +386,23 @@ AmountRecoveryResult<T> RangeProofLogic<T>::RecoverAmounts(
     using Scalar = typename T::Scalar;
     using Point = typename T::Point;
 
-    // will contain result of successful requests only
-    std::vector<range_proof::RecoveredData<T>> xs;
+    // amounts derived from the requests whose commitments
+    // have not been checked yet
+    struct Candidate {
+        size_t req_idx;
+        Point G;
+        Point H;
+        Scalar msg1_vs0;
+        Scalar vs0;
+        Scalar gamma_vs0;
+        Scalar tau1;
+        Scalar tau2;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(reqs.size());
 
     for (size_t i = 0; i < reqs.size(); ++i) {
-        auto req = reqs[i];
-        const range_proof::Generators<T> gens = m_common.Gf().GetInstance(req.seed);
-        Point G = gens.G;
-        Point H = gens.H;
+        const auto& req = reqs[i];
 
         // failure if sizes of Ls and Rs differ or Vs is empty
         auto Ls_Rs_valid = req.Ls.Size() > 0 && req.Ls.Size() == req.Rs.Size();
@@ -404,6 +413,7 @@ AmountRecoveryResult<T> RangeProofLogic<T>::RecoverAmounts(
         if (req.Vs.Size() != 1) {
             continue;
         }
+        const range_proof::Generators<T> gens = m_common.Gf().GetInstance(req.seed);
 
         // mu is defined to be: mu = alpha + rho * x
         //
@@ -428,25 +438,64 @@ AmountRecoveryResult<T> RangeProofLogic<T>::RecoverAmounts(
 
         Scalar msg1_vs0 = (req.mu - rho * req.x) - alpha;
 
-        auto maybe_msg_amt = range_proof::MsgAmtCipher<T>::Decrypt(
-            msg1_vs0,
-            gamma_vs0,
-            tau1,
-            tau2,
+        // lower 64 bits of msg1_vs0 is vs0
+        Scalar vs0 = msg1_vs0 & m_common.Uint64Max();
+
+        candidates.push_back({i, gens.G, gens.H, msg1_vs0, vs0, gamma_vs0, tau1, tau2});
+    }
+
+    // the commitment created from each recovered amount must match the one in
+    // the proof. check all of them at once with a random linear combination:
+    //
+    // sum_i r_i * (H_i * gamma_i + G_i * vs0_i - V_i) = 0
+    //
+    // and only check them one by one if that fails to find the bad ones
+    std::vector<bool> is_recovered(candidates.size(), true);
+    if (candidates.size() > 0) {
+        LazyPoints<T> lazy_points;
+        for (const auto& c : candidates) {
+            Scalar r = candidates.size() == 1 ? Scalar(1) : Scalar::Rand(true);
+            lazy_points.Add(c.H, r * c.gamma_vs0);
+            lazy_points.Add(c.G, r * c.vs0);
+            lazy_points.Add(reqs[c.req_idx].Vs[0], r.Negate());
+        }
+        if (!lazy_points.Sum().IsZero()) {
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                const auto& c = candidates[i];
+                Point act_vs0_commitment = (c.H * c.gamma_vs0) + (c.G * c.vs0);
+                is_recovered[i] = act_vs0_commitment == reqs[c.req_idx].Vs[0];
+            }
+        }
+    }
+
+    // invert x of all recovered proofs at once
+    Scalars xs_to_invert;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (is_recovered[i]) xs_to_invert.Add(reqs[candidates[i].req_idx].x);
+    }
+    Scalars x_invs = xs_to_invert.Empty() ? Scalars() : xs_to_invert.Invert();
+
+    // will contain result of successful requests only
+    std::vector<range_proof::RecoveredData<T>> xs;
+
+    for (size_t i = 0, j = 0; i < candidates.size(); ++i) {
+        if (!is_recovered[i]) continue;
+        const auto& c = candidates[i];
+        const auto& req = reqs[c.req_idx];
+
+        auto msg_amt = range_proof::MsgAmtCipher<T>::DecryptUnchecked(
+            c.msg1_vs0,
+            c.gamma_vs0,
+            c.tau1,
+            c.tau2,
             req.tau_x,
             req.x,
+            x_invs[j++],
             req.z,
-            m_common.Uint64Max(),
-            H,
-            G,
-            req.Vs[0]);
-        if (maybe_msg_amt == std::nullopt) {
-            continue;
-        }
-        auto msg_amt = maybe_msg_amt.value();
+            m_common.Uint64Max());
 
         auto x = range_proof::RecoveredData<T>(
-            i,
+            c.req_idx,
             msg_amt.amount,
             req.nonce.GetHashWithSalt(100), // gamma for vs[0]
             msg_amt.msg);
@@ -65,6 +65,7 @@ range_proof::Generators<T> range_proof::GeneratorsFactory<T>::GetInstance(const
     using Point = typename T::Point;
 
     // if G for the given seed hasn't been created, create and cache it
+    std::lock_guard<std::mutex> lock(GeneratorsFactory<T>::m_G_cache_mutex);
     if (m_G_cache.count(seed) == 0) {
         const Point G = m_deriver.Derive(m_H, 0, seed);
         m_G_cache.emplace(seed, G);
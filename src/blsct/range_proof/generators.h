@@ -73,6 +73,7 @@ private:
 
     // G generators are cached
     inline static std::map<const Seed, const Point> m_G_cache;
+    inline static std::mutex m_G_cache_mutex;
 
     inline static Point m_H;
     inline static Points m_Gi;
@@ -112,6 +112,47 @@ std::optional<MsgAmt> MsgAmtCipher<T>::Decrypt(
         return std::nullopt;
     }
 
+    return std::optional<MsgAmt> {DecryptUnchecked(
+        msg1_vs0,
+        gamma_vs0,
+        tau1,
+        tau2,
+        tau_x,
+        x,
+        x.Invert(),
+        z,
+        uint64_max
+    )};
+}
+template std::optional<MsgAmt> MsgAmtCipher<Mcl>::Decrypt(
+    const Mcl::Scalar& msg1_vs0,
+    const Mcl::Scalar& gamma_vs0,
+    const Mcl::Scalar& tau1,
+    const Mcl::Scalar& tau2,
+    const Mcl::Scalar& tau_x,
+    const Mcl::Scalar& x,
+    const Mcl::Scalar& z,
+    const Mcl::Scalar& uint64_max,
+    const Mcl::Point& H,
+    const Mcl::Point& G,
+    const Mcl::Point& exp_vs0_commitment
+);
+
+template <typename T>
+MsgAmt MsgAmtCipher<T>::DecryptUnchecked(
+    const Scalar& msg1_vs0,
+    const Scalar& gamma_vs0,
+    const Scalar& tau1,
+    const Scalar& tau2,
+    const Scalar& tau_x,
+    const Scalar& x,
+    const Scalar& x_inv,
+    const Scalar& z,
+    const Scalar& uint64_max
+) {
+    // lower 64 bits of msg1_vs0 is vs0
+    Scalar vs0 = msg1_vs0 & uint64_max;
+
     // msg1 starts from the 65th bit
     std::vector<uint8_t> msg1 = (msg1_vs0 >> 64).GetVch(true);
 
@@ -124,7 +165,7 @@ std::optional<MsgAmt> MsgAmtCipher<T>::Decrypt(
     // msg2 = (tau_x - tau2 * x^2 - z^2 * gamma) * x^-1 - tau1
     //
     Scalar msg2_scalar =
-        ((tau_x - (tau2 * x.Square()) - (z.Square() * gamma_vs0)) * x.Invert()) - tau1;
+        ((tau_x - (tau2 * x.Square()) - (z.Square() * gamma_vs0)) * x_inv) - tau1;
 
     std::vector<uint8_t> msg2 = msg2_scalar.GetVch(true);
 
@@ -134,20 +175,18 @@ std::optional<MsgAmt> MsgAmtCipher<T>::Decrypt(
 
     int64_t amount = (int64_t) vs0.GetUint64();
 
-    return std::optional<MsgAmt> {MsgAmt::of(msg, amount)};
+    return MsgAmt::of(msg, amount);
 }
-template std::optional<MsgAmt> MsgAmtCipher<Mcl>::Decrypt(
+template MsgAmt MsgAmtCipher<Mcl>::DecryptUnchecked(
     const Mcl::Scalar& msg1_vs0,
     const Mcl::Scalar& gamma_vs0,
     const Mcl::Scalar& tau1,
     const Mcl::Scalar& tau2,
     const Mcl::Scalar& tau_x,
     const Mcl::Scalar& x,
+    const Mcl::Scalar& x_inv,
     const Mcl::Scalar& z,
-    const Mcl::Scalar& uint64_max,
-    const Mcl::Point& H,
-    const Mcl::Point& G,
-    const Mcl::Point& exp_vs0_commitment
+    const Mcl::Scalar& uint64_max
 );
 
 } // namespace range_proof
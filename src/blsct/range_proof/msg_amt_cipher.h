@@ -64,6 +64,21 @@ struct MsgAmtCipher
         const Point& G,
         const Point& exp_vs0_commitment
     );
+
+    // same as Decrypt, but leaves the check of the vs0 commitment to
+    // the caller and takes the precomputed inverse of x so that both
+    // can be batched over multiple proofs
+    static MsgAmt DecryptUnchecked(
+        const Scalar& msg1_vs0,
+        const Scalar& gamma_vs0,
+        const Scalar& tau1,
+        const Scalar& tau2,
+        const Scalar& tau_x,
+        const Scalar& x,
+        const Scalar& x_inv,
+        const Scalar& z,
+        const Scalar& uint64_max
+    );
 };
 
 } // namespace range_proof
@@ -509,16 +509,35 @@ bulletproofs::AmountRecoveryResult<Arith> KeyMan::RecoverOutputs(const std::vect
 
     bulletproofs::RangeProofLogic<Arith> rp;
     std::vector<bulletproofs::AmountRecoveryRequest<Arith>> reqs;
+    std::vector<size_t> req_outs;
     reqs.reserve(outs.size());
+    req_outs.reserve(outs.size());
 
     for (size_t i = 0; i < outs.size(); i++) {
-        CTxOut out = outs[i];
+        const CTxOut& out = outs[i];
+        if (!out.IsBLSCT()) continue;
         auto nonce = CalculateNonce(out.blsctData.blindingKey, viewKey.GetScalar());
+
+        // Only request the outputs whose view tag matches, as outputs sent to
+        // other wallets would make the batched commitment check of
+        // RecoverAmounts fail and fall back to checking every output on its
+        // own. The view tag is derived from the nonce, see CalculateViewTag().
+        HashWriter view_tag{};
+        view_tag << nonce;
+        if ((view_tag.GetHash().GetUint64(0) & 0xFFFF) != out.blsctData.viewTag) continue;
+
         bulletproofs::RangeProofWithSeed<Arith> proof = {out.blsctData.rangeProof, out.tokenId};
         reqs.push_back(bulletproofs::AmountRecoveryRequest<Arith>::of(proof, nonce));
+        req_outs.push_back(i);
     }
 
-    return rp.RecoverAmounts(reqs);
+    auto result = rp.RecoverAmounts(reqs);
+
+    // Report the recovered amounts by the index of their output in outs
+    for (auto& amount : result.amounts) {
+        amount.id = req_outs[amount.id];
+    }
+    return result;
 }
 
 bool KeyMan::IsMine(const blsct::PublicKey& blindingKey, const blsct::PublicKey& spendingKey, const uint16_t& viewTag)
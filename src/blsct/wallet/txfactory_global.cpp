@@ -5,6 +5,9 @@
 #include <blsct/range_proof/bulletproofs/range_proof.h>
 #include <blsct/wallet/txfactory_global.h>
 
+#include <algorithm>
+#include <map>
+
 using T = Mcl;
 using Point = T::Point;
 using Points = Elements<Point>;
@@ -96,31 +99,101 @@ UnsignedOutput CreateOutput(const blsct::DoublePublicKey& destKeys, const CAmoun
     return ret;
 }
 
-CTransactionRef AggregateTransactions(const std::vector<CTransactionRef>& txs)
+void TxAggregator::Add(const CTransactionRef& tx)
 {
-    auto ret = CMutableTransaction();
-    std::vector<Signature> vSigs;
-    CAmount nFee = 0;
-
-    for (auto& tx : txs) {
-        vSigs.push_back(tx->txSig);
-        for (auto& in : tx->vin) {
-            ret.vin.push_back(in);
+    blsSignatureAdd(&m_sig.m_data, &tx->txSig.m_data);
+    m_txs.push_back(tx);
+    auto& component = m_components.emplace_back();
+
+    // an already aggregated tx keeps the signature terms of its cut-through
+    component.cut_through_terms = tx->vCutThrough;
+
+    for (size_t i = 0; i < tx->vin.size(); ++i) {
+        auto& in = tx->vin[i];
+        auto it = m_cut_through ? m_created.find(in.prevout) : m_created.end();
+        if (it != m_created.end() && it->second.first.IsBLSCT()) {
+            // the balance terms of the output and the input cancel out,
+            // only their signature terms need to be kept
+            const auto& [out, out_hash] = it->second;
+            component.cut_through_terms.emplace_back(out.blsctData.ephemeralKey, out_hash);
+            component.cut_through_terms.emplace_back(out.blsctData.spendingKey, tx->GetInHash(i));
+            component.spent.emplace_back(it->first, it->second);
+            m_created.erase(it);
+            continue;
         }
-        for (auto& out : tx->vout) {
-            if (out.scriptPubKey.IsFee()) {
-                nFee += out.nValue;
-                continue;
-            }
-            ret.vout.push_back(out);
+        component.vin.push_back(in);
+    }
+    for (size_t i = 0; i < tx->vout.size(); ++i) {
+        auto& out = tx->vout[i];
+        if (out.scriptPubKey.IsFee()) {
+            component.fee += out.nValue;
+            continue;
         }
+        COutPoint outpoint{tx->GetHash(), (uint32_t)i};
+        m_created.emplace(outpoint, std::make_pair(out, tx->GetOutHash(i)));
+        m_created_order.push_back(outpoint);
+    }
+    m_fee += component.fee;
+}
+
+bool TxAggregator::Remove(const Txid& txid)
+{
+    auto tx_it = std::find_if(m_txs.begin(), m_txs.end(), [&](const CTransactionRef& tx) { return tx->GetHash() == txid; });
+    if (tx_it == m_txs.end()) return false;
+    const auto& tx = *tx_it;
+    auto component_it = m_components.begin() + (tx_it - m_txs.begin());
+
+    for (size_t i = 0; i < tx->vout.size(); ++i) {
+        if (!tx->vout[i].scriptPubKey.IsFee() && !m_created.count(COutPoint{txid, (uint32_t)i})) return false;
+    }
+
+    for (size_t i = 0; i < tx->vout.size(); ++i) {
+        m_created.erase(COutPoint{txid, (uint32_t)i});
+    }
+    m_created_order.erase(std::remove_if(m_created_order.begin(), m_created_order.end(), [&](const COutPoint& outpoint) { return outpoint.hash == txid; }), m_created_order.end());
+
+    // the outputs cut through by the tx are part of the aggregate again, at
+    // the position they were created at
+    for (auto& [outpoint, created] : component_it->spent) {
+        m_created.emplace(outpoint, std::move(created));
     }
 
-    ret.vout.emplace_back(nFee, CScript{OP_RETURN});
+    m_fee -= component_it->fee;
+    blsSignatureSub(&m_sig.m_data, &tx->txSig.m_data);
 
-    ret.txSig = blsct::Signature::Aggregate(vSigs);
+    m_components.erase(component_it);
+    m_txs.erase(tx_it);
+    return true;
+}
+
+CTransactionRef TxAggregator::GetTransaction() const
+{
+    auto ret = CMutableTransaction();
+    for (const auto& component : m_components) {
+        ret.vin.insert(ret.vin.end(), component.vin.begin(), component.vin.end());
+        ret.vCutThrough.insert(ret.vCutThrough.end(), component.cut_through_terms.begin(), component.cut_through_terms.end());
+    }
+
+    // keep the order of the outputs which have not been cut through
+    ret.vout.reserve(m_created.size() + 1);
+    for (auto& outpoint : m_created_order) {
+        auto it = m_created.find(outpoint);
+        if (it != m_created.end()) ret.vout.push_back(it->second.first);
+    }
+    ret.vout.emplace_back(m_fee, CScript{OP_RETURN});
+
+    ret.txSig = m_sig;
     ret.nVersion = CTransaction::BLSCT_MARKER;
 
     return MakeTransactionRef(ret);
 }
+
+CTransactionRef AggregateTransactions(const std::vector<CTransactionRef>& txs, const bool& fCutThrough)
+{
+    TxAggregator aggregator{fCutThrough};
+    for (auto& tx : txs) {
+        aggregator.Add(tx);
+    }
+    return aggregator.GetTransaction();
+}
 } // namespace blsct
@@ -9,6 +9,8 @@
 #include <blsct/range_proof/bulletproofs/range_proof_logic.h>
 #include <primitives/transaction.h>
 
+#include <map>
+
 using T = Mcl;
 using Point = T::Point;
 using Points = Elements<Point>;
@@ -65,8 +67,58 @@ enum CreateTransactionType {
     STAKED_COMMITMENT_UNSTAKE
 };
 
+/**
+ * Keeps a running aggregate of transactions, so that adding or removing a
+ * transaction only costs the size of that transaction instead of
+ * re-aggregating all the other ones. Cut-through follows the rules of
+ * AggregateTransactions.
+ */
+class TxAggregator
+{
+public:
+    explicit TxAggregator(const bool& fCutThrough = false) : m_cut_through(fCutThrough) {}
+
+    void Add(const CTransactionRef& tx);
+    /** Remove a tx added before. Fails if the tx is not part of the aggregate
+      * or if an output of it was cut through by another tx, which has to be
+      * removed first. */
+    bool Remove(const Txid& txid);
+    CTransactionRef GetTransaction() const;
+    const std::vector<CTransactionRef>& GetTransactions() const { return m_txs; }
+    size_t Size() const { return m_txs.size(); }
+
+private:
+    using CreatedOutput = std::pair<CTxOut, uint256>;
+
+    // what a tx contributed to the aggregate
+    struct Component {
+        std::vector<CTxIn> vin;
+        std::vector<CTxCutThroughTerm> cut_through_terms;
+        // outputs of other txs cut through by the inputs of this one
+        std::vector<std::pair<COutPoint, CreatedOutput>> spent;
+        CAmount fee{0};
+    };
+
+    bool m_cut_through;
+    std::vector<CTransactionRef> m_txs;
+    std::vector<Component> m_components;
+    CAmount m_fee{0};
+    Signature m_sig;
+
+    // outputs created by the txs which have not been spent by them yet,
+    // with their hashes
+    std::map<COutPoint, CreatedOutput> m_created;
+    std::vector<COutPoint> m_created_order;
+};
+
+/**
+ * Aggregates txs into a single transaction. When fCutThrough is set, outputs
+ * created and spent by the txs are removed together with the inputs spending
+ * them, and only the signature terms of both are kept in vCutThrough. txs
+ * must then be sorted so that parents come before their children.
+ */
 CTransactionRef
-AggregateTransactions(const std::vector<CTransactionRef>& txs);
+AggregateTransactions(const std::vector<CTransactionRef>& txs, const bool& fCutThrough = false);
 UnsignedOutput CreateOutput(const blsct::DoublePublicKey& destination, const CAmount& nAmount, std::string sMemo, const TokenId& tokenId = TokenId(), const Scalar& blindingKey = Scalar::Rand(), const CreateTransactionType& type = NORMAL, const CAmount& minStake = 0);
 } // namespace blsct
 
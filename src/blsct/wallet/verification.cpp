@@ -9,9 +9,125 @@
 #include <blsct/range_proof/bulletproofs/range_proof_logic.h>
 #include <blsct/range_proof/generators.h>
 #include <blsct/wallet/verification.h>
+#include <crypto/common.h>
+#include <crypto/sha256.h>
+#include <cuckoocache.h>
+#include <logging.h>
+#include <random.h>
+#include <util/hasher.h>
 #include <util/strencodings.h>
 
+#include <optional>
+#include <shared_mutex>
+
 namespace blsct {
+namespace {
+/**
+ * Valid range proof cache, keyed by output so that proofs checked when a
+ * transaction entered the memory pool are not checked again when it is
+ * connected, including as part of an aggregated block transaction.
+ */
+class CRangeProofCache
+{
+private:
+    //! Entries are SHA256(nonce || output hash || minimum stake)
+    CSHA256 m_salted_hasher;
+    CuckooCache::cache<uint256, SignatureCacheHasher> m_valid;
+    std::shared_mutex m_mutex;
+
+public:
+    CRangeProofCache()
+    {
+        uint256 nonce = GetRandHash();
+        static constexpr unsigned char PADDING[32] = {'R'};
+        m_salted_hasher.Write(nonce.begin(), 32);
+        m_salted_hasher.Write(PADDING, 32);
+    }
+
+    uint256 ComputeEntry(const uint256& out_hash, const CAmount& minStake) const
+    {
+        uint256 entry;
+        unsigned char stake[8];
+        WriteLE64(stake, minStake);
+        CSHA256 hasher = m_salted_hasher;
+        hasher.Write(out_hash.begin(), 32).Write(stake, sizeof(stake)).Finalize(entry.begin());
+        return entry;
+    }
+
+    bool Get(const uint256& entry)
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return m_valid.contains(entry, /*erase=*/false);
+    }
+
+    void Set(const uint256& entry)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_valid.insert(entry);
+    }
+
+    std::optional<std::pair<uint32_t, size_t>> setup_bytes(size_t n)
+    {
+        return m_valid.setup_bytes(n);
+    }
+};
+
+static CRangeProofCache rangeProofCache;
+
+void AddRangeProofs(const CTxOut& out, const CAmount& minStake, std::vector<bulletproofs::RangeProofWithSeed<Mcl>>& vProofs)
+{
+    vProofs.emplace_back(out.blsctData.rangeProof, out.tokenId);
+
+    bulletproofs::RangeProofWithSeed<Mcl> stakedCommitmentRangeProof;
+    if (out.GetStakedCommitmentRangeProof(stakedCommitmentRangeProof)) {
+        stakedCommitmentRangeProof.Vs.Clear();
+        stakedCommitmentRangeProof.Vs.Add(out.blsctData.rangeProof.Vs[0]);
+
+        vProofs.emplace_back(stakedCommitmentRangeProof, TokenId(), minStake);
+    }
+}
+} // namespace
+
+bool InitRangeProofCache(size_t max_size_bytes)
+{
+    auto setup_results = rangeProofCache.setup_bytes(max_size_bytes);
+    if (!setup_results) return false;
+
+    const auto [num_elems, approx_size_bytes] = *setup_results;
+    LogPrintf("Using %zu MiB out of %zu MiB requested for range proof cache, able to store %zu elements\n",
+              approx_size_bytes >> 20, max_size_bytes >> 20, num_elems);
+    return true;
+}
+
+bool PreVerifyTx(const CTransaction& tx, TxValidationState& state, const CAmount& minStake)
+{
+    bulletproofs::RangeProofLogic<Mcl> rp;
+    std::vector<bulletproofs::RangeProofWithSeed<Mcl>> vProofs;
+    std::vector<uint256> vEntries;
+
+    for (size_t i = 0; i < tx.vout.size(); ++i) {
+        auto& out = tx.vout[i];
+        if (!out.IsBLSCT()) continue;
+
+        auto entry = rangeProofCache.ComputeEntry(tx.GetOutHash(i), minStake);
+        if (rangeProofCache.Get(entry)) continue;
+
+        AddRangeProofs(out, minStake, vProofs);
+        vEntries.push_back(entry);
+    }
+
+    if (vProofs.empty()) return true;
+
+    if (!rp.Verify(vProofs))
+        return state.Invalid(TxValidationResult::TX_CONSENSUS, "failed-rangeproof-check");
+
+    for (auto& entry : vEntries) {
+        rangeProofCache.Set(entry);
+    }
+
+    return true;
+}
+
 bool VerifyTx(const CTransaction& tx, const CCoinsViewCache& view, TxValidationState& state, const CAmount& blockReward, const CAmount& minStake)
 {
     if (!view.HaveInputs(tx)) {
@@ -31,41 +147,34 @@ bool VerifyTx(const CTransaction& tx, const CCoinsViewCache& view, TxValidationS
     }
 
     if (!tx.IsCoinBase()) {
-        for (auto& in : tx.vin) {
+        for (size_t i = 0; i < tx.vin.size(); ++i) {
             Coin coin;
 
-            if (!view.GetCoin(in.prevout, coin)) {
+            if (!view.GetCoin(tx.vin[i].prevout, coin)) {
                 return state.Invalid(TxValidationResult::TX_MISSING_INPUTS, "bad-input-unknown");
             }
 
             vPubKeys.emplace_back(coin.out.blsctData.spendingKey);
-            auto in_hash = in.GetHash();
+            auto in_hash = tx.GetInHash(i);
             vMessages.emplace_back(in_hash.begin(), in_hash.end());
             balanceKey = balanceKey + coin.out.blsctData.rangeProof.Vs[0];
         }
     }
 
     CAmount nFee = 0;
-    bulletproofs::RangeProofWithSeed<Mcl> stakedCommitmentRangeProof;
 
-    for (auto& out : tx.vout) {
+    for (size_t i = 0; i < tx.vout.size(); ++i) {
+        auto& out = tx.vout[i];
         if (out.IsBLSCT()) {
-            bulletproofs::RangeProofWithSeed<Mcl> proof{out.blsctData.rangeProof, out.tokenId};
-            auto out_hash = out.GetHash();
+            auto out_hash = tx.GetOutHash(i);
 
             vPubKeys.emplace_back(out.blsctData.ephemeralKey);
             vMessages.emplace_back(out_hash.begin(), out_hash.end());
-            vProofs.emplace_back(proof);
 
             balanceKey = balanceKey - out.blsctData.rangeProof.Vs[0];
 
-            if (out.GetStakedCommitmentRangeProof(stakedCommitmentRangeProof)) {
-                stakedCommitmentRangeProof.Vs.Clear();
-                stakedCommitmentRangeProof.Vs.Add(out.blsctData.rangeProof.Vs[0]);
-
-                proof = bulletproofs::RangeProofWithSeed<Mcl>{stakedCommitmentRangeProof, TokenId(), minStake};
-
-                vProofs.push_back(proof);
+            if (!rangeProofCache.Get(rangeProofCache.ComputeEntry(out_hash, minStake))) {
+                AddRangeProofs(out, minStake, vProofs);
             }
         } else {
             if (!out.scriptPubKey.IsUnspendable() && out.nValue > 0) {
@@ -81,6 +190,13 @@ bool VerifyTx(const CTransaction& tx, const CCoinsViewCache& view, TxValidationS
         }
     }
 
+    // outputs created and spent inside of the transaction were removed
+    // together with their inputs, but are still part of the signature
+    for (auto& term : tx.vCutThrough) {
+        vPubKeys.emplace_back(term.publicKey);
+        vMessages.emplace_back(term.messageHash.begin(), term.messageHash.end());
+    }
+
     vMessages.emplace_back(blsct::Common::BLSCTBALANCE);
     vPubKeys.emplace_back(balanceKey);
 
@@ -89,7 +205,7 @@ bool VerifyTx(const CTransaction& tx, const CCoinsViewCache& view, TxValidationS
     if (!sigCheck)
         return state.Invalid(TxValidationResult::TX_CONSENSUS, "failed-signature-check");
 
-    auto rpCheck = rp.Verify(vProofs);
+    auto rpCheck = vProofs.empty() || rp.Verify(vProofs);
 
     if (!rpCheck)
         return state.Invalid(TxValidationResult::TX_CONSENSUS, "failed-rangeproof-check");
@@ -9,7 +9,19 @@
 #include <coins.h>
 #include <consensus/validation.h>
 
+// Range proofs of outputs are cached once verified, so that they are not
+// checked again when the transaction is connected
+static constexpr size_t DEFAULT_MAX_RANGE_PROOF_CACHE_BYTES{4 << 20};
+
 namespace blsct {
+[[nodiscard]] bool InitRangeProofCache(size_t max_size_bytes);
+
+/**
+ * Checks the parts of a transaction which do not depend on the UTXO set
+ * (its range proofs) and caches the result, so that it can be called before
+ * taking cs_main. VerifyTx skips the range proofs found in the cache.
+ */
+bool PreVerifyTx(const CTransaction& tx, TxValidationState& state, const CAmount& minStake = 0);
 bool VerifyTx(const CTransaction& tx, const CCoinsViewCache& view, TxValidationState& state, const CAmount& blockReward = 0, const CAmount& minStake = 0);
 }
 #endif // BLSCT_VERIFICATION_H
@@ -214,6 +214,10 @@ public:
     //! (memory only) Maximum nTime in the chain up to and including this block.
     unsigned int nTimeMax{0};
 
+    //! (memory only) Last block up to and including this one that generated a
+    //! stake modifier, or nullptr if there is none.
+    const CBlockIndex* pindexStakeModifier{nullptr};
+
     explicit CBlockIndex(const CBlockHeader& block)
         : nVersion{block.nVersion},
           hashMerkleRoot{block.hashMerkleRoot},
@@ -318,6 +322,13 @@ public:
         nStakeModifier = nModifier;
         if (fGeneratedStakeModifier)
             nStatus |= BLOCK_STAKE_MODIFIER;
+        UpdateStakeModifierIndex();
+    }
+
+    void UpdateStakeModifierIndex() EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+    {
+        AssertLockHeld(::cs_main);
+        pindexStakeModifier = GeneratedStakeModifier() ? this : (pprev ? pprev->pindexStakeModifier : nullptr);
     }
 
     bool GeneratedStakeModifier() const EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
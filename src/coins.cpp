@@ -41,7 +41,7 @@ CCoinsViewCache::CCoinsViewCache(CCoinsView* baseIn, bool deterministic) :
 
 size_t CCoinsViewCache::DynamicMemoryUsage() const
 {
-    return memusage::DynamicUsage(cacheCoins) + cachedCoinsUsage;
+    return memusage::DynamicUsage(cacheCoins) + cachedCoinsUsage + RecursiveDynamicUsage(cacheStakedCommitments);
 }
 
 CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint& outpoint) const
@@ -127,6 +127,11 @@ void CCoinsViewCache::EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coi
         std::forward_as_tuple(std::move(coin), CCoinsCacheEntry::DIRTY));
 }
 
+void CCoinsViewCache::SetStakedCommitmentsInternalDANGER(OrderedElements<MclG1Point>&& staked_commitments)
+{
+    cacheStakedCommitments = std::move(staked_commitments);
+}
+
 void AddCoins(CCoinsViewCache& cache, const CTransaction& tx, int nHeight, bool check_for_overwrite)
 {
     bool fCoinbase = tx.IsCoinBase();
@@ -91,7 +91,7 @@ public:
 
     size_t DynamicMemoryUsage() const
     {
-        return memusage::DynamicUsage(out.scriptPubKey);
+        return RecursiveDynamicUsage(out);
     }
 };
 
@@ -311,6 +311,15 @@ public:
      */
     void EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coin);
 
+    /**
+     * Replace the staked commitments without checking them against the coins.
+     *
+     * NOT FOR GENERAL USE. Used only when loading coins from a UTXO snapshot,
+     * which are emplaced without updating the staked commitments.
+     * @sa ChainstateManager::PopulateAndValidateSnapshot()
+     */
+    void SetStakedCommitmentsInternalDANGER(OrderedElements<MclG1Point>&& staked_commitments);
+
     /**
      * Spend a coin. Pass moveto in order to get the deleted data.
      * If no unspent output exists for the passed outpoint, this call
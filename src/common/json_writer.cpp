@@ -0,0 +1,96 @@
+// Copyright (c) 2024 The Navio developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <common/json_writer.h>
+
+#include <univalue.h>
+#include <util/check.h>
+
+#include <utility>
+
+namespace common {
+
+JSONWriter::JSONWriter(Sink sink, size_t flush_size)
+    : m_sink{std::move(sink)}, m_flush_size{flush_size} {}
+
+void JSONWriter::Separate()
+{
+    if (m_after_key) {
+        m_after_key = false;
+        return;
+    }
+    if (m_has_members.empty()) return;
+    if (m_has_members.back()) m_buffer += ',';
+    m_has_members.back() = true;
+}
+
+void JSONWriter::MaybeFlush()
+{
+    if (m_buffer.size() < m_flush_size) return;
+    m_sink(std::exchange(m_buffer, {}));
+}
+
+void JSONWriter::BeginObject()
+{
+    Separate();
+    m_buffer += '{';
+    m_has_members.push_back(false);
+}
+
+void JSONWriter::EndObject()
+{
+    Assume(!m_has_members.empty() && !m_after_key);
+    m_has_members.pop_back();
+    m_buffer += '}';
+    MaybeFlush();
+}
+
+void JSONWriter::BeginArray()
+{
+    Separate();
+    m_buffer += '[';
+    m_has_members.push_back(false);
+}
+
+void JSONWriter::EndArray()
+{
+    Assume(!m_has_members.empty());
+    m_has_members.pop_back();
+    m_buffer += ']';
+    MaybeFlush();
+}
+
+void JSONWriter::Key(std::string_view key)
+{
+    Assume(!m_after_key);
+    Separate();
+    m_buffer += UniValue{std::string{key}}.write();
+    m_buffer += ':';
+    m_after_key = true;
+}
+
+void JSONWriter::Value(const UniValue& value)
+{
+    Separate();
+    m_buffer += value.write();
+    MaybeFlush();
+}
+
+void JSONWriter::Members(const UniValue& obj)
+{
+    const auto& keys{obj.getKeys()};
+    const auto& values{obj.getValues()};
+    for (size_t i = 0; i < keys.size(); ++i) {
+        Key(keys[i]);
+        Value(values[i]);
+    }
+}
+
+std::string JSONWriter::Finish()
+{
+    Assume(m_has_members.empty());
+    return std::exchange(m_buffer, {});
+}
+
+} // namespace common
@@ -0,0 +1,70 @@
+// Copyright (c) 2024 The Navio developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_COMMON_JSON_WRITER_H
+#define BITCOIN_COMMON_JSON_WRITER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class UniValue;
+
+namespace common {
+
+/**
+ * Writes a JSON document piece by piece instead of building it as a single
+ * UniValue first. Objects and arrays are opened and closed explicitly and
+ * their members are written as they are produced, so a large document is
+ * only held as text plus the member being written. Whenever more than
+ * flush_size bytes of text are buffered they are handed to the sink.
+ *
+ * The text is the same as UniValue::write() without indentation would give
+ * for the equivalent UniValue.
+ */
+class JSONWriter
+{
+public:
+    using Sink = std::function<void(std::string&&)>;
+
+    static constexpr size_t DEFAULT_FLUSH_SIZE{1 << 16};
+
+    explicit JSONWriter(Sink sink, size_t flush_size = DEFAULT_FLUSH_SIZE);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    //! Start a member of the innermost object. Its value must follow.
+    void Key(std::string_view key);
+    //! Write an element of the innermost array or the value of the last key.
+    void Value(const UniValue& value);
+    //! Write every member of obj as a member of the innermost object.
+    void Members(const UniValue& obj);
+
+    //! Whether a key has been written whose value has not been started yet.
+    bool AfterKey() const { return m_after_key; }
+
+    //! Return the text that has not been handed to the sink yet.
+    [[nodiscard]] std::string Finish();
+
+private:
+    //! Write a comma if the innermost object or array already has members.
+    void Separate();
+    void MaybeFlush();
+
+    const Sink m_sink;
+    const size_t m_flush_size;
+    std::string m_buffer;
+    //! Whether each open object or array already has a member, innermost last
+    std::vector<bool> m_has_members;
+    bool m_after_key{false};
+};
+
+} // namespace common
+
+#endif // BITCOIN_COMMON_JSON_WRITER_H
@@ -25,12 +25,31 @@ static inline size_t RecursiveDynamicUsage(const CTxIn& in) {
     return mem;
 }
 
+template <typename T>
+static inline size_t RecursiveDynamicUsage(const Elements<T>& elements) {
+    return memusage::DynamicUsage(elements.m_vec);
+}
+
+template <typename T>
+static inline size_t RecursiveDynamicUsage(const OrderedElements<T>& elements) {
+    return memusage::DynamicUsage(elements.m_set);
+}
+
+static inline size_t RecursiveDynamicUsage(const CTxOutBLSCTData& data) {
+    const auto& proof = data.rangeProof;
+    return RecursiveDynamicUsage(proof.Vs) + RecursiveDynamicUsage(proof.Ls) + RecursiveDynamicUsage(proof.Rs);
+}
+
 static inline size_t RecursiveDynamicUsage(const CTxOut& out) {
-    return RecursiveDynamicUsage(out.scriptPubKey);
+    return RecursiveDynamicUsage(out.scriptPubKey) + RecursiveDynamicUsage(out.blsctData);
 }
 
 static inline size_t RecursiveDynamicUsage(const CTransaction& tx) {
-    size_t mem = memusage::DynamicUsage(tx.vin) + memusage::DynamicUsage(tx.vout);
+    size_t mem = memusage::DynamicUsage(tx.vin) + memusage::DynamicUsage(tx.vout) + memusage::DynamicUsage(tx.vCutThrough);
+    if (tx.IsBLSCT()) {
+        // cached input and output hashes
+        mem += memusage::MallocUsage(sizeof(uint256) * tx.vin.size()) + memusage::MallocUsage(sizeof(uint256) * tx.vout.size());
+    }
     for (std::vector<CTxIn>::const_iterator it = tx.vin.begin(); it != tx.vin.end(); it++) {
         mem += RecursiveDynamicUsage(*it);
     }
@@ -41,7 +60,7 @@ static inline size_t RecursiveDynamicUsage(const CTransaction& tx) {
 }
 
 static inline size_t RecursiveDynamicUsage(const CMutableTransaction& tx) {
-    size_t mem = memusage::DynamicUsage(tx.vin) + memusage::DynamicUsage(tx.vout);
+    size_t mem = memusage::DynamicUsage(tx.vin) + memusage::DynamicUsage(tx.vout) + memusage::DynamicUsage(tx.vCutThrough);
     for (std::vector<CTxIn>::const_iterator it = tx.vin.begin(); it != tx.vin.end(); it++) {
         mem += RecursiveDynamicUsage(*it);
     }
@@ -23,4 +23,12 @@ static const int DANDELION_MAX_ROUTES = 2;
 /** Expected time between Dandelion++ routing shuffles (in seconds). */
 static constexpr auto DANDELION_SHUFFLE_INTERVAL = 600s;
 
+/** Average delay between the Dandelion++ stem announcements sent along one
+ *  route, shorter than the normal transaction relay trickle. */
+static constexpr auto DANDELION_STEM_INVENTORY_INTERVAL = 1s;
+
+/** Maximum total virtual size of the transactions kept in stem phase. Stem
+ *  transactions beyond it are fluffed right away. */
+static constexpr int64_t DANDELION_MAX_STEMPOOL_VSIZE{5'000'000};
+
 #endif // BITCOIN_DANDELION_H
@@ -5,12 +5,14 @@
 #include <httprpc.h>
 
 #include <common/args.h>
+#include <common/json_writer.h>
 #include <crypto/hmac_sha256.h>
 #include <httpserver.h>
 #include <logging.h>
 #include <netaddress.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
+#include <span.h>
 #include <util/strencodings.h>
 #include <util/string.h>
 #include <walletinitinterface.h>
@@ -200,10 +202,32 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
                 req->WriteReply(HTTP_FORBIDDEN);
                 return false;
             }
-            UniValue result = tableRPC.execute(jreq);
-
-            // Send reply
-            strReply = JSONRPCReply(result, NullUniValue, jreq.id);
+            // Write the reply as it is produced, so that methods with a large
+            // result can hand it over piece by piece through result_writer.
+            HTTPReplyStream stream{req, "application/json"};
+            common::JSONWriter writer{[&](std::string&& text) { stream.Write(MakeByteSpan(text)); }};
+            writer.BeginObject();
+            writer.Key("result");
+            jreq.result_writer = &writer;
+            UniValue result;
+            try {
+                result = tableRPC.execute(jreq);
+            } catch (...) {
+                if (!stream.Started()) throw;
+                // The status is out already, all the client gets is a truncated reply.
+                LogPrintf("RPC method %s failed after part of its reply was sent\n", jreq.strMethod);
+                stream.Finish();
+                return false;
+            }
+            if (writer.AfterKey()) writer.Value(result);
+            writer.Key("error");
+            writer.Value(NullUniValue);
+            writer.Key("id");
+            writer.Value(jreq.id);
+            writer.EndObject();
+            stream.Write(MakeByteSpan(writer.Finish() + "\n"));
+            stream.Finish();
+            return true;
 
         // array of requests
         } else if (valRequest.isArray()) {
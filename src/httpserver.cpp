@@ -20,8 +20,13 @@
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/threadnames.h>
+#include <util/time.h>
 #include <util/translation.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
@@ -30,6 +35,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -47,6 +53,9 @@
 /** Maximum size of http request (request line + headers) */
 static const size_t MAX_HEADERS_SIZE = 8192;
 
+/** Maximum size of a chunked reply that is waiting to be written to the socket */
+static constexpr size_t MAX_UNSENT_REPLY_SIZE{4 << 20};
+
 /** HTTP request work item */
 class HTTPWorkItem final : public HTTPClosure
 {
@@ -67,72 +76,154 @@ private:
     HTTPRequestHandler func;
 };
 
-/** Simple work queue for distributing work over multiple threads.
+/** Work queue for distributing work over multiple threads.
  * Work items are simply callable objects.
+ *
+ * Every worker has a deque of its own, so that workers taking work and the
+ * event thread handing it out rarely contend for a lock. New work is spread
+ * over the deques round-robin. A worker takes work from the front of its own
+ * deque and, once that is empty, steals from the back of the others. Idle
+ * workers sleep on a shared condition variable, which is only touched when
+ * one of them is asleep.
  */
 template <typename WorkItem>
 class WorkQueue
 {
 private:
-    Mutex cs;
-    std::condition_variable cond GUARDED_BY(cs);
-    std::deque<std::unique_ptr<WorkItem>> queue GUARDED_BY(cs);
-    bool running GUARDED_BY(cs){true};
+    struct Entry {
+        std::unique_ptr<WorkItem> item;
+        HTTPRequestCost cost;
+        SteadyClock::time_point enqueued;
+    };
+    struct Stripe {
+        Mutex cs;
+        std::deque<Entry> queue GUARDED_BY(cs);
+    };
+
+    std::vector<Stripe> m_stripes;
     const size_t maxDepth;
+    const size_t m_max_expensive;
+    //! Items in all deques, and those of them with HTTPRequestCost::HIGH
+    std::atomic<size_t> m_depth{0};
+    std::atomic<size_t> m_expensive{0};
+    std::atomic<size_t> m_next_stripe{0};
+    std::atomic<bool> m_running{true};
+
+    Mutex m_sleep_cs;
+    std::condition_variable m_sleep_cond;
+    std::atomic<int> m_sleeping{0};
+
+    std::atomic<uint64_t> m_rejected{0};
+    std::atomic<uint64_t> m_stolen{0};
+    std::array<std::atomic<uint64_t>, HTTP_QUEUE_WAIT_BUCKETS.size() + 1> m_wait_counts{};
+
+    std::optional<Entry> Pop(size_t worker)
+    {
+        std::optional<Entry> entry;
+        for (size_t i = 0; i < m_stripes.size() && !entry; ++i) {
+            Stripe& stripe = m_stripes[(worker + i) % m_stripes.size()];
+            LOCK(stripe.cs);
+            if (stripe.queue.empty()) continue;
+            if (i == 0) {
+                entry = std::move(stripe.queue.front());
+                stripe.queue.pop_front();
+            } else {
+                entry = std::move(stripe.queue.back());
+                stripe.queue.pop_back();
+                ++m_stolen;
+            }
+        }
+        if (entry) {
+            --m_depth;
+            if (entry->cost == HTTPRequestCost::HIGH) --m_expensive;
+            const auto waited{SteadyClock::now() - entry->enqueued};
+            const auto bucket{std::lower_bound(HTTP_QUEUE_WAIT_BUCKETS.begin(), HTTP_QUEUE_WAIT_BUCKETS.end(), waited)};
+            ++m_wait_counts[bucket - HTTP_QUEUE_WAIT_BUCKETS.begin()];
+        }
+        return entry;
+    }
 
 public:
-    explicit WorkQueue(size_t _maxDepth) : maxDepth(_maxDepth)
+    WorkQueue(size_t _maxDepth, size_t workers)
+        : m_stripes(workers), maxDepth(_maxDepth), m_max_expensive(std::max<size_t>(_maxDepth / 2, 1))
     {
     }
     /** Precondition: worker threads have all stopped (they have been joined).
      */
     ~WorkQueue() = default;
+    size_t NumWorkers() const { return m_stripes.size(); }
     /** Enqueue a work item */
-    bool Enqueue(WorkItem* item) EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    bool Enqueue(WorkItem* item, HTTPRequestCost cost) EXCLUSIVE_LOCKS_REQUIRED(!m_sleep_cs)
     {
-        LOCK(cs);
-        if (!running || queue.size() >= maxDepth) {
+        if (!m_running) {
+            return false;
+        }
+        if (m_depth++ >= maxDepth) {
+            --m_depth;
+            ++m_rejected;
+            return false;
+        }
+        if (cost == HTTPRequestCost::HIGH && m_expensive++ >= m_max_expensive) {
+            --m_expensive;
+            --m_depth;
+            ++m_rejected;
             return false;
         }
-        queue.emplace_back(std::unique_ptr<WorkItem>(item));
-        cond.notify_one();
+        Stripe& stripe = m_stripes[m_next_stripe++ % m_stripes.size()];
+        WITH_LOCK(stripe.cs, stripe.queue.push_back({std::unique_ptr<WorkItem>(item), cost, SteadyClock::now()}));
+        // A worker going to sleep counts itself as sleeping before it checks
+        // for work, so either it sees this item or it is woken up here.
+        if (m_sleeping > 0) {
+            LOCK(m_sleep_cs);
+            m_sleep_cond.notify_one();
+        }
         return true;
     }
     /** Thread function */
-    void Run() EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    void Run(size_t worker) EXCLUSIVE_LOCKS_REQUIRED(!m_sleep_cs)
     {
         while (true) {
-            std::unique_ptr<WorkItem> i;
-            {
-                WAIT_LOCK(cs, lock);
-                while (running && queue.empty())
-                    cond.wait(lock);
-                if (!running && queue.empty())
-                    break;
-                i = std::move(queue.front());
-                queue.pop_front();
+            std::optional<Entry> entry{Pop(worker)};
+            if (!entry) {
+                WAIT_LOCK(m_sleep_cs, lock);
+                ++m_sleeping;
+                // Items are counted in m_depth before they are pushed, so an
+                // item that is not in its deque yet keeps this worker looking.
+                m_sleep_cond.wait(lock, [&] { return m_depth > 0 || !m_running; });
+                --m_sleeping;
+                if (!m_running && m_depth == 0) break;
+                continue;
             }
-            (*i)();
+            (*entry->item)();
         }
     }
     /** Interrupt and exit loops */
-    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!m_sleep_cs)
+    {
+        m_running = false;
+        LOCK(m_sleep_cs);
+        m_sleep_cond.notify_all();
+    }
+    HTTPWorkQueueStats GetStats() const
     {
-        LOCK(cs);
-        running = false;
-        cond.notify_all();
+        HTTPWorkQueueStats stats{m_depth, maxDepth, m_rejected, m_stolen, {}};
+        for (size_t i = 0; i < m_wait_counts.size(); ++i) {
+            stats.wait_counts[i] = m_wait_counts[i];
+        }
+        return stats;
     }
 };
 
 struct HTTPPathHandler
 {
-    HTTPPathHandler(std::string _prefix, bool _exactMatch, HTTPRequestHandler _handler):
-        prefix(_prefix), exactMatch(_exactMatch), handler(_handler)
+    HTTPPathHandler(std::string _prefix, bool _exactMatch, HTTPRequestHandler _handler, HTTPRequestCost _cost):
+        prefix(_prefix), exactMatch(_exactMatch), handler(_handler), cost(_cost)
     {
     }
     std::string prefix;
     bool exactMatch;
     HTTPRequestHandler handler;
+    HTTPRequestCost cost;
 };
 
 /** HTTP module state */
@@ -145,6 +236,8 @@ static struct evhttp* eventHTTP = nullptr;
 static std::vector<CSubNet> rpc_allow_subnets;
 //! Work queue for handling longer requests off the event loop thread
 static std::unique_ptr<WorkQueue<HTTPClosure>> g_work_queue{nullptr};
+//! How long in total a chunked reply may wait for its client to read it, see -rpcservertimeout
+static std::chrono::seconds g_reply_wait_timeout{DEFAULT_HTTP_SERVER_TIMEOUT};
 //! Handlers for (sub)paths
 static GlobalMutex g_httppathhandlers_mutex;
 static std::vector<HTTPPathHandler> pathHandlers GUARDED_BY(g_httppathhandlers_mutex);
@@ -327,7 +420,7 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
     if (i != iend) {
         std::unique_ptr<HTTPWorkItem> item(new HTTPWorkItem(std::move(hreq), path, i->handler));
         assert(g_work_queue);
-        if (g_work_queue->Enqueue(item.get())) {
+        if (g_work_queue->Enqueue(item.get(), i->cost)) {
             item.release(); /* if true, queue took ownership */
         } else {
             LogPrintf("WARNING: request rejected because http work queue depth exceeded, it can be increased with the -rpcworkqueue= setting\n");
@@ -401,7 +494,7 @@ static bool HTTPBindAddresses(struct evhttp* http)
 static void HTTPWorkQueueRun(WorkQueue<HTTPClosure>* queue, int worker_num)
 {
     util::ThreadRename(strprintf("httpworker.%i", worker_num));
-    queue->Run();
+    queue->Run(worker_num);
 }
 
 /** libevent event log callback */
@@ -451,7 +544,9 @@ bool InitHTTPServer(const util::SignalInterrupt& interrupt)
         return false;
     }
 
-    evhttp_set_timeout(http, gArgs.GetIntArg("-rpcservertimeout", DEFAULT_HTTP_SERVER_TIMEOUT));
+    const int64_t server_timeout{gArgs.GetIntArg("-rpcservertimeout", DEFAULT_HTTP_SERVER_TIMEOUT)};
+    evhttp_set_timeout(http, server_timeout);
+    g_reply_wait_timeout = std::chrono::seconds{server_timeout};
     evhttp_set_max_headers_size(http, MAX_HEADERS_SIZE);
     evhttp_set_max_body_size(http, MAX_SIZE);
     evhttp_set_gencb(http, http_request_cb, (void*)&interrupt);
@@ -463,9 +558,10 @@ bool InitHTTPServer(const util::SignalInterrupt& interrupt)
 
     LogPrint(BCLog::HTTP, "Initialized HTTP server\n");
     int workQueueDepth = std::max((long)gArgs.GetIntArg("-rpcworkqueue", DEFAULT_HTTP_WORKQUEUE), 1L);
-    LogDebug(BCLog::HTTP, "creating work queue of depth %d\n", workQueueDepth);
+    int rpcThreads = std::max((long)gArgs.GetIntArg("-rpcthreads", DEFAULT_HTTP_THREADS), 1L);
+    LogDebug(BCLog::HTTP, "creating work queue of depth %d for %d workers\n", workQueueDepth, rpcThreads);
 
-    g_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
+    g_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth, rpcThreads);
     // transfer ownership to eventBase/HTTP via .release()
     eventBase = base_ctr.release();
     eventHTTP = http_ctr.release();
@@ -485,7 +581,7 @@ static std::vector<std::thread> g_thread_http_workers;
 
 void StartHTTPServer()
 {
-    int rpcThreads = std::max((long)gArgs.GetIntArg("-rpcthreads", DEFAULT_HTTP_THREADS), 1L);
+    const int rpcThreads = g_work_queue->NumWorkers();
     LogInfo("Starting HTTP server with %d worker threads\n", rpcThreads);
     g_thread_http = std::thread(ThreadHTTP, eventBase);
 
@@ -547,6 +643,12 @@ void StopHTTPServer()
     LogPrint(BCLog::HTTP, "Stopped HTTP server\n");
 }
 
+std::optional<HTTPWorkQueueStats> GetHTTPWorkQueueStats()
+{
+    if (!g_work_queue) return std::nullopt;
+    return g_work_queue->GetStats();
+}
+
 struct event_base* EventBase()
 {
     return eventBase;
@@ -578,6 +680,21 @@ void HTTPEvent::trigger(struct timeval* tv)
     else
         evtimer_add(ev, tv); // trigger after timeval passed
 }
+struct HTTPRequest::ChunkedReply {
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    //! Bytes passed to WriteReplyChunk that have not been written to the socket
+    size_t m_unsent GUARDED_BY(m_mutex){0};
+    //! Part of m_unsent that has already been handed to libevent
+    size_t m_in_libevent GUARDED_BY(m_mutex){0};
+    //! Whether the connection has been closed before the end of the reply
+    bool m_closed GUARDED_BY(m_mutex){false};
+    //! How much longer WriteReplyChunk may wait for the client to catch up
+    std::chrono::steady_clock::duration m_wait_left GUARDED_BY(m_mutex){g_reply_wait_timeout};
+    //! Whether the client was too slow, in which case the connection is dropped
+    bool m_aborted GUARDED_BY(m_mutex){false};
+};
+
 HTTPRequest::HTTPRequest(struct evhttp_request* _req, const util::SignalInterrupt& interrupt, bool _replySent)
     : req(_req), m_interrupt(interrupt), replySent(_replySent)
 {
@@ -585,7 +702,11 @@ HTTPRequest::HTTPRequest(struct evhttp_request* _req, const util::SignalInterrup
 
 HTTPRequest::~HTTPRequest()
 {
-    if (!replySent) {
+    if (m_chunked_reply && !replySent) {
+        // The status is already out, so all that is left is to end the body.
+        LogPrintf("%s: Unfinished reply\n", __func__);
+        WriteReplyEnd();
+    } else if (!replySent) {
         // Keep track of whether reply was sent to avoid request leaks
         LogPrintf("%s: Unhandled request\n", __func__);
         WriteReply(HTTP_INTERNAL_SERVER_ERROR, "Unhandled request");
@@ -666,6 +787,144 @@ void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
     req = nullptr; // transferred back to main thread
 }
 
+void HTTPRequest::WriteReplyStart(int nStatus)
+{
+    assert(!replySent && !m_chunked_reply && req);
+    if (m_interrupt) {
+        WriteHeader("Connection", "close");
+    }
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
+        evhttp_send_reply_start(req_copy, nStatus, nullptr);
+    });
+    ev->trigger(nullptr);
+    m_chunked_reply = std::make_shared<ChunkedReply>();
+}
+
+bool HTTPRequest::WriteReplyChunk(std::string&& chunk)
+{
+    assert(!replySent && m_chunked_reply && req);
+    if (chunk.empty()) return true;
+    auto req_copy = req;
+    auto reply = m_chunked_reply;
+    {
+        WAIT_LOCK(reply->m_mutex, lock);
+        while (!reply->m_closed && !reply->m_aborted && reply->m_unsent > MAX_UNSENT_REPLY_SIZE) {
+            if (m_interrupt) return false;
+            // Don't let a client that reads slowly hold on to the worker
+            // thread for good.
+            if (reply->m_wait_left <= 0s) {
+                LogPrint(BCLog::HTTP, "Aborting reply to %s, the client is not reading it fast enough\n", GetPeer().ToStringAddrPort());
+                reply->m_aborted = true;
+                break;
+            }
+            const auto wait_start{std::chrono::steady_clock::now()};
+            const auto status{reply->m_cv.wait_for(lock, std::min<std::chrono::steady_clock::duration>(1s, reply->m_wait_left))};
+            reply->m_wait_left -= std::chrono::steady_clock::now() - wait_start;
+            if (status == std::cv_status::timeout) {
+                // libevent does not tell when it drops the connection of a
+                // request that is being replied to, so look for it.
+                HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, reply]{
+                    if (evhttp_request_get_connection(req_copy)) return;
+                    WITH_LOCK(reply->m_mutex, reply->m_closed = true);
+                    reply->m_cv.notify_all();
+                });
+                ev->trigger(nullptr);
+            }
+        }
+        if (reply->m_closed || reply->m_aborted) return false;
+        reply->m_unsent += chunk.size();
+    }
+    // Events are handled in the order they are triggered, so the chunks
+    // arrive in order.
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, reply, chunk = std::move(chunk)]{
+        if (!evhttp_request_get_connection(req_copy)) {
+            WITH_LOCK(reply->m_mutex, reply->m_closed = true);
+            reply->m_cv.notify_all();
+            return;
+        }
+        WITH_LOCK(reply->m_mutex, reply->m_in_libevent += chunk.size());
+        struct evbuffer* evb = evbuffer_new();
+        assert(evb);
+        evbuffer_add(evb, chunk.data(), chunk.size());
+        // The callback runs once everything handed to libevent so far has
+        // been written to the socket.
+        evhttp_send_reply_chunk_with_cb(req_copy, evb, [](evhttp_connection*, void* arg) {
+            auto& reply = *static_cast<ChunkedReply*>(arg);
+            {
+                LOCK(reply.m_mutex);
+                reply.m_unsent -= reply.m_in_libevent;
+                reply.m_in_libevent = 0;
+            }
+            reply.m_cv.notify_all();
+        }, reply.get());
+        evbuffer_free(evb);
+    });
+    ev->trigger(nullptr);
+    return true;
+}
+
+void HTTPRequest::WriteReplyEnd()
+{
+    assert(!replySent && m_chunked_reply && req);
+    auto req_copy = req;
+    // The reply state has to outlive the last chunk callback, which ending
+    // the reply replaces.
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, reply = m_chunked_reply]{
+        if (WITH_LOCK(reply->m_mutex, return reply->m_aborted)) {
+            // Drop the connection rather than end the body, so that the
+            // client can tell that the reply is incomplete.
+            if (evhttp_connection* conn = evhttp_request_get_connection(req_copy)) {
+                evhttp_connection_free(conn);
+                return;
+            }
+        }
+        // Re-enable reading from the socket first, as the request may be
+        // freed by the end of the reply. This is the second part of the
+        // libevent workaround above.
+        if (event_get_version_number() >= 0x02010600 && event_get_version_number() < 0x02010900) {
+            evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+            if (conn) {
+                bufferevent* bev = evhttp_connection_get_bufferevent(conn);
+                if (bev) {
+                    bufferevent_enable(bev, EV_READ | EV_WRITE);
+                }
+            }
+        }
+        evhttp_send_reply_end(req_copy);
+    });
+    ev->trigger(nullptr);
+    replySent = true;
+    req = nullptr; // transferred back to main thread
+}
+
+bool HTTPReplyStream::Write(Span<const std::byte> data)
+{
+    if (!m_good) return false;
+    m_buffer.append(reinterpret_cast<const char*>(data.data()), data.size());
+    if (m_buffer.size() >= CHUNK_SIZE) {
+        if (!m_started) {
+            m_req->WriteHeader("Content-Type", m_content_type);
+            m_req->WriteReplyStart(HTTP_OK);
+            m_started = true;
+        }
+        m_good = m_req->WriteReplyChunk(std::move(m_buffer));
+        m_buffer.clear();
+    }
+    return m_good;
+}
+
+void HTTPReplyStream::Finish()
+{
+    if (!m_started) {
+        m_req->WriteHeader("Content-Type", m_content_type);
+        m_req->WriteReply(HTTP_OK, m_buffer);
+        return;
+    }
+    if (m_good) m_req->WriteReplyChunk(std::move(m_buffer));
+    m_req->WriteReplyEnd();
+}
+
 CService HTTPRequest::GetPeer() const
 {
     evhttp_connection* con = evhttp_request_get_connection(req);
@@ -741,11 +1000,11 @@ std::optional<std::string> GetQueryParameterFromUri(const char* uri, const std::
     return result;
 }
 
-void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler)
+void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler, HTTPRequestCost cost)
 {
     LogPrint(BCLog::HTTP, "Registering HTTP handler for %s (exactmatch %d)\n", prefix, exactMatch);
     LOCK(g_httppathhandlers_mutex);
-    pathHandlers.emplace_back(prefix, exactMatch, handler);
+    pathHandlers.emplace_back(prefix, exactMatch, handler, cost);
 }
 
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch)
@@ -5,8 +5,13 @@
 #ifndef BITCOIN_HTTPSERVER_H
 #define BITCOIN_HTTPSERVER_H
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <span.h>
 #include <string>
 
 namespace util {
@@ -36,16 +41,52 @@ void InterruptHTTPServer();
 /** Stop HTTP server */
 void StopHTTPServer();
 
+/** Upper bounds of the buckets of the histogram of the time requests wait in the work queue */
+static constexpr std::array<std::chrono::microseconds, 5> HTTP_QUEUE_WAIT_BUCKETS{
+    std::chrono::microseconds{100},
+    std::chrono::microseconds{1'000},
+    std::chrono::microseconds{10'000},
+    std::chrono::microseconds{100'000},
+    std::chrono::microseconds{1'000'000},
+};
+
+struct HTTPWorkQueueStats {
+    //! Number of requests waiting for a worker
+    size_t depth;
+    size_t max_depth;
+    //! Number of requests rejected because the queue was full
+    uint64_t rejected;
+    //! Number of requests taken from the queue of another worker
+    uint64_t stolen;
+    //! Number of requests per bucket of HTTP_QUEUE_WAIT_BUCKETS, the last
+    //! one counting requests that waited longer than all bounds
+    std::array<uint64_t, HTTP_QUEUE_WAIT_BUCKETS.size() + 1> wait_counts;
+};
+
+/** Get statistics of the work queue, or std::nullopt if the server is not running */
+std::optional<HTTPWorkQueueStats> GetHTTPWorkQueueStats();
+
 /** Change logging level for libevent. */
 void UpdateHTTPServerLogging(bool enable);
 
 /** Handler for requests to a certain HTTP path */
 typedef std::function<bool(HTTPRequest* req, const std::string &)> HTTPRequestHandler;
+
+/** How much work the handler of a request does, used to admit requests to the work queue */
+enum class HTTPRequestCost {
+    //! Requests answered from memory or with a few lookups
+    NORMAL,
+    //! Requests that read or serialize many blocks or transactions. They are
+    //! only admitted while they take up less than half of the work queue, so
+    //! a burst of them cannot lock out everything else.
+    HIGH,
+};
+
 /** Register handler for prefix.
  * If multiple handlers match a prefix, the first-registered one will
  * be invoked.
  */
-void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler);
+void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler, HTTPRequestCost cost = HTTPRequestCost::NORMAL);
 /** Unregister handler for prefix */
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch);
 
@@ -64,6 +105,10 @@ private:
     const util::SignalInterrupt& m_interrupt;
     bool replySent;
 
+    struct ChunkedReply;
+    //! Flow control state of a reply started with WriteReplyStart
+    std::shared_ptr<ChunkedReply> m_chunked_reply;
+
 public:
     explicit HTTPRequest(struct evhttp_request* req, const util::SignalInterrupt& interrupt, bool replySent = false);
     ~HTTPRequest();
@@ -129,6 +174,70 @@ public:
      * main thread, do not call any other HTTPRequest methods after calling this.
      */
     void WriteReply(int nStatus, const std::string& strReply = "");
+
+    /**
+     * Start an HTTP reply whose body is sent in parts as it is produced,
+     * using chunked transfer encoding. nStatus and the headers written so far
+     * are sent right away. Send the body with WriteReplyChunk and finish the
+     * reply with WriteReplyEnd.
+     *
+     * @note Can be called only once, instead of WriteReply.
+     */
+    void WriteReplyStart(int nStatus);
+
+    /**
+     * Send the next part of a reply started with WriteReplyStart. Blocks
+     * while the client is behind on reading earlier parts, so that a large
+     * reply is never buffered in full.
+     *
+     * A reply that has kept the worker waiting for the client for more than
+     * -rpcservertimeout seconds in total is aborted, and its connection is
+     * dropped when the reply is finished.
+     *
+     * @returns false if the client has gone away, the reply was aborted or
+     *          the node is shutting down, in which case the caller should
+     *          stop producing the body and finish the reply.
+     */
+    bool WriteReplyChunk(std::string&& chunk);
+
+    /**
+     * Finish a reply started with WriteReplyStart. As this will give the
+     * request back to the main thread, do not call any other HTTPRequest
+     * methods after calling this.
+     */
+    void WriteReplyEnd();
+};
+
+/**
+ * The body of a successful reply, produced piece by piece. Bodies smaller
+ * than CHUNK_SIZE are sent in one go; larger ones are sent with chunked
+ * transfer encoding while they are being produced. The Content-Type header
+ * is written when the reply goes out, so that an error reply can still be
+ * sent instead as long as nothing has been sent.
+ */
+class HTTPReplyStream
+{
+public:
+    static constexpr size_t CHUNK_SIZE{1 << 16};
+
+    HTTPReplyStream(HTTPRequest* req, std::string content_type)
+        : m_req{req}, m_content_type{std::move(content_type)} {}
+
+    //! Append data to the body. Returns false once the client has gone away.
+    bool Write(Span<const std::byte> data);
+
+    //! Whether part of the body has been sent, so the status can no longer change.
+    bool Started() const { return m_started; }
+
+    //! Send the rest of the body and finish the reply.
+    void Finish();
+
+private:
+    HTTPRequest* const m_req;
+    const std::string m_content_type;
+    std::string m_buffer;
+    bool m_started{false};
+    bool m_good{true};
 };
 
 /** Get the query parameter value from request uri for a specified key, or std::nullopt if the key
@@ -4,6 +4,7 @@
 
 #include <chainparams.h>
 #include <common/args.h>
+#include <common/system.h>
 #include <index/base.h>
 #include <interfaces/chain.h>
 #include <kernel/chain.h>
@@ -13,19 +14,32 @@
 #include <node/context.h>
 #include <node/database_args.h>
 #include <node/interface_ui.h>
+#include <sync.h>
 #include <tinyformat.h>
+#include <undo.h>
 #include <util/thread.h>
 #include <util/translation.h>
 #include <validation.h> // For g_chainman
 #include <warnings.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 constexpr uint8_t DB_BEST_BLOCK{'B'};
 
 constexpr auto SYNC_LOG_INTERVAL{30s};
 constexpr auto SYNC_LOCATOR_WRITE_INTERVAL{30s};
+//! Upper bound on the threads each index reads blocks on during sync
+constexpr int MAX_SYNC_PREFETCH_THREADS{4};
+//! Number of blocks read ahead of the block being indexed, per prefetch thread
+constexpr size_t SYNC_PREFETCH_WINDOW{4};
 
 template <typename... Args>
 void BaseIndex::FatalErrorf(const char* fmt, const Args&... args)
@@ -141,12 +155,164 @@ static const CBlockIndex* NextSyncBlock(const CBlockIndex* pindex_prev, CChain&
     return chain.Next(chain.FindFork(pindex_prev));
 }
 
+bool BaseIndex::PrefetchBlock(const CBlockIndex& block_index, CBlock& block, CBlockUndo& block_undo, std::any& prepared) const
+{
+    if (!m_chainstate->m_blockman.ReadBlockFromDisk(block, block_index)) {
+        return false;
+    }
+    interfaces::BlockInfo block_info = kernel::MakeBlockInfo(&block_index, &block);
+    if (ReadsUndoData() && block_index.nHeight > 0) {
+        if (!m_chainstate->m_blockman.UndoReadFromDisk(block_undo, block_index)) {
+            return false;
+        }
+        block_info.undo_data = &block_undo;
+    }
+    prepared = CustomPrepare(block_info);
+    return true;
+}
+
+namespace {
+
+/**
+ * Reads the blocks the sync thread is about to index on a few worker
+ * threads, so that deserialization and CustomPrepare of later blocks overlap
+ * with CustomAppend of the current one. Blocks are handed back in the order
+ * they were pushed.
+ */
+class BlockPrefetcher
+{
+public:
+    struct Item {
+        const CBlockIndex* block_index;
+        CBlock block;
+        CBlockUndo block_undo;
+        std::any prepared;
+        bool ok{false};
+    };
+
+private:
+    struct Job {
+        Item item;
+        bool done{false};
+    };
+
+    const std::function<bool(const CBlockIndex&, CBlock&, CBlockUndo&, std::any&)> m_prefetch;
+
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    //! Pushed blocks that have not been popped yet, in push order
+    std::deque<std::shared_ptr<Job>> m_jobs GUARDED_BY(m_mutex);
+    //! Position in m_jobs of the first job no worker has picked up yet
+    size_t m_next_job GUARDED_BY(m_mutex){0};
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_threads;
+
+    void Loop()
+    {
+        while (true) {
+            std::shared_ptr<Job> job;
+            {
+                WAIT_LOCK(m_mutex, lock);
+                m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || m_next_job < m_jobs.size(); });
+                if (m_stop) return;
+                job = m_jobs[m_next_job++];
+            }
+            Item& item = job->item;
+            item.ok = m_prefetch(*item.block_index, item.block, item.block_undo, item.prepared);
+            {
+                LOCK(m_mutex);
+                job->done = true;
+            }
+            m_cv.notify_all();
+        }
+    }
+
+public:
+    BlockPrefetcher(const std::string& name, int n_threads, decltype(m_prefetch) prefetch)
+        : m_prefetch{std::move(prefetch)}
+    {
+        for (int i = 0; i < n_threads; ++i) {
+            m_threads.emplace_back(&util::TraceThread, strprintf("%s.%d", name, i), [this] { Loop(); });
+        }
+    }
+
+    ~BlockPrefetcher()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_cv.notify_all();
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    size_t Size() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        return m_jobs.size();
+    }
+
+    /** The block the next call to Pop returns, if any. */
+    const CBlockIndex* Front() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        return m_jobs.empty() ? nullptr : m_jobs.front()->item.block_index;
+    }
+
+    void Push(const CBlockIndex* block_index) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        auto job{std::make_shared<Job>()};
+        job->item.block_index = block_index;
+        WITH_LOCK(m_mutex, m_jobs.push_back(std::move(job)));
+        m_cv.notify_all();
+    }
+
+    /** Wait for the oldest pushed block to be read and return it. */
+    std::shared_ptr<Item> Pop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        assert(!m_jobs.empty());
+        if (m_next_job == 0) {
+            // Nobody picked the block up yet, read it on this thread instead.
+            std::shared_ptr<Job> job{m_jobs.front()};
+            m_jobs.pop_front();
+            REVERSE_LOCK(lock);
+            Item& item = job->item;
+            item.ok = m_prefetch(*item.block_index, item.block, item.block_undo, item.prepared);
+            return {job, &job->item};
+        }
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_jobs.front()->done; });
+        std::shared_ptr<Job> job{m_jobs.front()};
+        m_jobs.pop_front();
+        --m_next_job;
+        return {job, &job->item};
+    }
+
+    /** Drop all pushed blocks, e.g. after the chain being synced reorged. */
+    void Clear() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        // Jobs that are being worked on are kept alive by their worker.
+        LOCK(m_mutex);
+        m_jobs.clear();
+        m_next_job = 0;
+    }
+};
+
+} // namespace
+
 void BaseIndex::ThreadSync()
 {
     const CBlockIndex* pindex = m_best_block_index.load();
     if (!m_synced) {
         std::chrono::steady_clock::time_point last_log_time{0s};
         std::chrono::steady_clock::time_point last_locator_write_time{0s};
+
+        const int n_threads{std::clamp(GetNumCores() - 1, 1, MAX_SYNC_PREFETCH_THREADS)};
+        BlockPrefetcher prefetcher{GetName(), n_threads, [this](const CBlockIndex& block_index, CBlock& block, CBlockUndo& block_undo, std::any& prepared) {
+            return PrefetchBlock(block_index, block, block_undo, prepared);
+        }};
+        // Last block pushed to the prefetcher
+        const CBlockIndex* pindex_prefetched{nullptr};
+
         while (true) {
             if (m_interrupt) {
                 LogPrintf("%s: m_interrupt set; exiting ThreadSync\n", GetName());
@@ -175,6 +341,19 @@ void BaseIndex::ThreadSync()
                     return;
                 }
                 pindex = pindex_next;
+
+                // Keep the prefetcher a few blocks ahead along the active chain,
+                // starting over if the blocks it holds are no longer the next ones.
+                if (prefetcher.Front() != pindex) {
+                    prefetcher.Clear();
+                    pindex_prefetched = pindex->pprev;
+                }
+                while (prefetcher.Size() < SYNC_PREFETCH_WINDOW * static_cast<size_t>(n_threads)) {
+                    const CBlockIndex* pindex_ahead = pindex_prefetched ? m_chainstate->m_chain.Next(pindex_prefetched) : m_chainstate->m_chain.Genesis();
+                    if (!pindex_ahead) break;
+                    prefetcher.Push(pindex_ahead);
+                    pindex_prefetched = pindex_ahead;
+                }
             }
 
             auto current_time{std::chrono::steady_clock::now()};
@@ -191,16 +370,18 @@ void BaseIndex::ThreadSync()
                 Commit();
             }
 
-            CBlock block;
-            interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex);
-            if (!m_chainstate->m_blockman.ReadBlockFromDisk(block, *pindex)) {
+            auto item{prefetcher.Pop()};
+            assert(item->block_index == pindex);
+            if (!item->ok) {
                 FatalErrorf("%s: Failed to read block %s from disk",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
-            } else {
-                block_info.data = &block;
             }
-            if (!CustomAppend(block_info)) {
+            interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex, &item->block);
+            if (ReadsUndoData() && pindex->nHeight > 0) {
+                block_info.undo_data = &item->block_undo;
+            }
+            if (!CustomAppendPrepared(block_info, std::move(item->prepared))) {
                 FatalErrorf("%s: Failed to write block %s to index database",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
@@ -236,7 +417,8 @@ bool BaseIndex::Commit()
 
 bool BaseIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
 {
-    assert(current_tip == m_best_block_index);
+    // During the initial sync m_best_block_index lags behind current_tip, as
+    // it is only updated when the locator is written.
     assert(current_tip->GetAncestor(new_tip->nHeight) == new_tip);
 
     if (!CustomRewind({current_tip->GetBlockHash(), current_tip->nHeight}, {new_tip->GetBlockHash(), new_tip->nHeight})) {
@@ -302,7 +484,16 @@ void BaseIndex::BlockConnected(ChainstateRole role, const std::shared_ptr<const
         }
     }
     interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex, block.get());
-    if (CustomAppend(block_info)) {
+    CBlockUndo block_undo;
+    if (ReadsUndoData() && pindex->nHeight > 0) {
+        if (!m_chainstate->m_blockman.UndoReadFromDisk(block_undo, *pindex)) {
+            FatalErrorf("%s: Failed to read undo data of block %s from disk",
+                       __func__, pindex->GetBlockHash().ToString());
+            return;
+        }
+        block_info.undo_data = &block_undo;
+    }
+    if (CustomAppendPrepared(block_info, CustomPrepare(block_info))) {
         // Setting the best block index is intentionally the last step of this
         // function, so BlockUntilSyncedToCurrentChain callers waiting for the
         // best block index to be updated can rely on the block being fully
@@ -10,10 +10,12 @@
 #include <util/threadinterrupt.h>
 #include <validationinterface.h>
 
+#include <any>
 #include <string>
 
 class CBlock;
 class CBlockIndex;
+class CBlockUndo;
 class Chainstate;
 class ChainstateManager;
 namespace interfaces {
@@ -100,6 +102,16 @@ private:
 
     virtual bool AllowPrune() const = 0;
 
+    /// Whether blocks should be passed to the index together with their undo
+    /// data, in which case BlockInfo::undo_data is set for every block but
+    /// the genesis block. During the initial sync the undo data is read ahead
+    /// on the prefetch threads.
+    virtual bool ReadsUndoData() const { return false; }
+
+    /// Read a block, and its undo data if the index wants it, and run
+    /// CustomPrepare on it. Called on the prefetch threads during sync.
+    bool PrefetchBlock(const CBlockIndex& block_index, CBlock& block, CBlockUndo& block_undo, std::any& prepared) const;
+
     template <typename... Args>
     void FatalErrorf(const char* fmt, const Args&... args);
 
@@ -118,6 +130,17 @@ protected:
     /// Write update index entries for a newly connected block.
     [[nodiscard]] virtual bool CustomAppend(const interfaces::BlockInfo& block) { return true; }
 
+    /// Do the part of the work for a block that does not depend on earlier
+    /// blocks, e.g. building its filter. During the initial sync this is
+    /// called on several threads at once, out of order and ahead of the
+    /// block being appended, so it must not touch mutable index state. The
+    /// result is handed to CustomAppendPrepared.
+    [[nodiscard]] virtual std::any CustomPrepare(const interfaces::BlockInfo& block) const { return {}; }
+
+    /// Write update index entries for a newly connected block, given the
+    /// result of CustomPrepare for it. Blocks are always appended in order.
+    [[nodiscard]] virtual bool CustomAppendPrepared(const interfaces::BlockInfo& block, std::any&& prepared) { return CustomAppend(block); }
+
     /// Virtual method called internally by Commit that can be overridden to atomically
     /// commit more index state.
     virtual bool CustomCommit(CDBBatch& batch) { return true; }
@@ -44,12 +44,17 @@ private:
 
     bool AllowPrune() const override { return true; }
 
+    bool ReadsUndoData() const override { return true; }
+
 protected:
     bool CustomInit(const std::optional<interfaces::BlockKey>& block) override;
 
     bool CustomCommit(CDBBatch& batch) override;
 
-    bool CustomAppend(const interfaces::BlockInfo& block) override;
+    /** Build the filter of the block; its header needs the previous one and is computed when appending. */
+    std::any CustomPrepare(const interfaces::BlockInfo& block) const override;
+
+    bool CustomAppendPrepared(const interfaces::BlockInfo& block, std::any&& prepared) override;
 
     bool CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip) override;
 
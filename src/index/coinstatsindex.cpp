@@ -23,6 +23,10 @@ using kernel::RemoveCoinHash;
 static constexpr uint8_t DB_BLOCK_HASH{'s'};
 static constexpr uint8_t DB_BLOCK_HEIGHT{'t'};
 static constexpr uint8_t DB_MUHASH{'M'};
+static constexpr uint8_t DB_COIN_HASH_VERSION{'V'};
+
+//! Version of the coin serialization hashed into the muhash, see kernel::ApplyCoinHash
+static constexpr uint8_t COIN_HASH_VERSION{2};
 
 namespace {
 
@@ -110,11 +114,58 @@ CoinStatsIndex::CoinStatsIndex(std::unique_ptr<interfaces::Chain> chain, size_t
     fs::create_directories(path);
 
     m_db = std::make_unique<CoinStatsIndex::DB>(path / "db", n_cache_size, f_memory, f_wipe);
+
+    // The muhash of an index built with another coin serialization cannot be
+    // extended, so such an index is rebuilt from scratch.
+    uint8_t version{0};
+    if (!m_db->Read(DB_COIN_HASH_VERSION, version) || version != COIN_HASH_VERSION) {
+        if (!m_db->IsEmpty()) {
+            LogPrintf("%s: Index was built with an older coin hash, rebuilding it\n", GetName());
+            m_db.reset();
+            m_db = std::make_unique<CoinStatsIndex::DB>(path / "db", n_cache_size, f_memory, /*f_wipe=*/true);
+        }
+        m_db->Write(DB_COIN_HASH_VERSION, COIN_HASH_VERSION);
+    }
 }
 
-bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
+std::any CoinStatsIndex::CustomPrepare(const interfaces::BlockInfo& block) const
+{
+    // The coins a block creates and spends are hashed here, on the prefetch
+    // threads during sync, and the result is multiplied into m_muhash by
+    // CustomAppendPrepared.
+    MuHash3072 muhash;
+    if (block.height == 0) return muhash;
+
+    // pindex variable gives indexing code access to node internals. It
+    // will be removed in upcoming commit
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return m_chainstate->m_blockman.LookupBlockIndex(block.hash));
+    const CBlockUndo& block_undo{*Assert(block.undo_data)};
+    assert(block.data);
+    for (size_t i = 0; i < block.data->vtx.size(); ++i) {
+        const auto& tx{block.data->vtx.at(i)};
+
+        // Skip duplicate txid coinbase transactions (BIP30).
+        if (IsBIP30Unspendable(*pindex) && tx->IsCoinBase()) continue;
+
+        for (uint32_t j = 0; j < tx->vout.size(); ++j) {
+            const CTxOut& out{tx->vout[j]};
+            if (out.scriptPubKey.IsUnspendable()) continue;
+            ApplyCoinHash(muhash, COutPoint{tx->GetHash(), j}, Coin{out, block.height, tx->IsCoinBase()});
+        }
+
+        // The coinbase tx has no undo data since no former output is spent
+        if (!tx->IsCoinBase()) {
+            const auto& tx_undo{block_undo.vtxundo.at(i - 1)};
+            for (size_t j = 0; j < tx_undo.vprevout.size(); ++j) {
+                RemoveCoinHash(muhash, COutPoint{tx->vin[j].prevout.hash, tx->vin[j].prevout.n}, tx_undo.vprevout[j]);
+            }
+        }
+    }
+    return muhash;
+}
+
+bool CoinStatsIndex::CustomAppendPrepared(const interfaces::BlockInfo& block, std::any&& prepared)
 {
-    CBlockUndo block_undo;
     const CAmount block_subsidy{GetBlockSubsidy(block.height, Params().GetConsensus())};
     m_total_subsidy += block_subsidy;
 
@@ -123,9 +174,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
         // pindex variable gives indexing code access to node internals. It
         // will be removed in upcoming commit
         const CBlockIndex* pindex = WITH_LOCK(cs_main, return m_chainstate->m_blockman.LookupBlockIndex(block.hash));
-        if (!m_chainstate->m_blockman.UndoReadFromDisk(block_undo, *pindex)) {
-            return false;
-        }
+        const CBlockUndo& block_undo{*Assert(block.undo_data)};
 
         std::pair<uint256, DBVal> read_out;
         if (!m_db->Read(DBHeightKey(block.height - 1), read_out)) {
@@ -155,29 +204,23 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                 continue;
             }
 
-            for (uint32_t j = 0; j < tx->vout.size(); ++j) {
-                const CTxOut& out{tx->vout[j]};
-                Coin coin{out, block.height, tx->IsCoinBase()};
-                COutPoint outpoint{tx->GetHash(), j};
-
+            for (const CTxOut& out : tx->vout) {
                 // Skip unspendable coins
-                if (coin.out.scriptPubKey.IsUnspendable()) {
-                    m_total_unspendable_amount += coin.out.nValue;
-                    m_total_unspendables_scripts += coin.out.nValue;
+                if (out.scriptPubKey.IsUnspendable()) {
+                    m_total_unspendable_amount += out.nValue;
+                    m_total_unspendables_scripts += out.nValue;
                     continue;
                 }
 
-                ApplyCoinHash(m_muhash, outpoint, coin);
-
                 if (tx->IsCoinBase()) {
-                    m_total_coinbase_amount += coin.out.nValue;
+                    m_total_coinbase_amount += out.nValue;
                 } else {
-                    m_total_new_outputs_ex_coinbase_amount += coin.out.nValue;
+                    m_total_new_outputs_ex_coinbase_amount += out.nValue;
                 }
 
                 ++m_transaction_output_count;
-                m_total_amount += coin.out.nValue;
-                m_bogo_size += GetBogoSize(coin.out.scriptPubKey);
+                m_total_amount += out.nValue;
+                m_bogo_size += GetBogoSize(out.scriptPubKey);
             }
 
             // The coinbase tx has no undo data since no former output is spent
@@ -185,10 +228,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                 const auto& tx_undo{block_undo.vtxundo.at(i - 1)};
 
                 for (size_t j = 0; j < tx_undo.vprevout.size(); ++j) {
-                    Coin coin{tx_undo.vprevout[j]};
-                    COutPoint outpoint{tx->vin[j].prevout.hash, tx->vin[j].prevout.n};
-
-                    RemoveCoinHash(m_muhash, outpoint, coin);
+                    const Coin& coin{tx_undo.vprevout[j]};
 
                     m_total_prevout_spent_amount += coin.out.nValue;
 
@@ -212,6 +252,8 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
     m_total_unspendable_amount += unclaimed_rewards;
     m_total_unspendables_unclaimed_rewards += unclaimed_rewards;
 
+    m_muhash *= std::any_cast<const MuHash3072&>(prepared);
+
     std::pair<uint256, DBVal> value;
     value.first = block.hash;
     value.second.transaction_output_count = m_transaction_output_count;
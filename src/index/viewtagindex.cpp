@@ -0,0 +1,145 @@
+// Copyright (c) 2024 The Navio developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/viewtagindex.h>
+
+#include <chain.h>
+#include <common/args.h>
+#include <dbwrapper.h>
+#include <interfaces/chain.h>
+#include <logging.h>
+#include <primitives/block.h>
+
+#include <algorithm>
+
+constexpr uint8_t DB_VIEWTAG_HEIGHT{'v'};
+
+std::unique_ptr<ViewTagIndex> g_viewtagindex;
+
+namespace {
+
+/**
+ * Entries are keyed by height, big-endian, so that a range of blocks is
+ * read with a single forward iteration. Entries left behind by a reorg are
+ * overwritten when the replacement block is indexed and are never served
+ * in the meantime, because lookups compare the stored block hash against
+ * the requested chain.
+ */
+struct DBHeightKey {
+    int height;
+
+    explicit DBHeightKey(int height_in) : height(height_in) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_VIEWTAG_HEIGHT);
+        ser_writedata32be(s, height);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_VIEWTAG_HEIGHT) {
+            throw std::ios_base::failure("Invalid format for viewtagindex DB height key");
+        }
+        height = ser_readdata32be(s);
+    }
+};
+
+}; // namespace
+
+/** Access to the viewtagindex database (indexes/viewtagindex/) */
+class ViewTagIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+};
+
+ViewTagIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(gArgs.GetDataDirNet() / "indexes" / "viewtagindex", n_cache_size, f_memory, f_wipe)
+{}
+
+ViewTagIndex::ViewTagIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe)
+    : BaseIndex(std::move(chain), "viewtagindex"), m_db(std::make_unique<ViewTagIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+ViewTagIndex::~ViewTagIndex() = default;
+
+std::any ViewTagIndex::CustomPrepare(const interfaces::BlockInfo& block) const
+{
+    assert(block.data);
+
+    ViewTagEntries entries;
+    entries.block_hash = block.hash;
+    for (const auto& tx : block.data->vtx) {
+        for (uint32_t n = 0; n < tx->vout.size(); ++n) {
+            const CTxOut& out = tx->vout[n];
+            if (!out.IsBLSCT()) continue;
+
+            const auto blinding_key = out.blsctData.blindingKey.GetVch();
+            const auto spending_key = out.blsctData.spendingKey.GetVch();
+
+            entries.view_tags.push_back(out.blsctData.viewTag);
+            std::copy(blinding_key.begin(), blinding_key.end(), entries.blinding_keys.emplace_back().begin());
+            entries.outpoints.emplace_back(tx->GetHash(), n);
+            std::copy(spending_key.begin(), spending_key.end(), entries.spending_keys.emplace_back().begin());
+        }
+    }
+
+    return entries;
+}
+
+bool ViewTagIndex::CustomAppendPrepared(const interfaces::BlockInfo& block, std::any&& prepared)
+{
+    return m_db->Write(DBHeightKey(block.height), std::any_cast<const ViewTagEntries&>(prepared));
+}
+
+BaseIndex::DB& ViewTagIndex::GetDB() const { return *m_db; }
+
+bool ViewTagIndex::LookUpViewTags(int start_height, const CBlockIndex* stop_index, std::vector<ViewTagEntries>& entries) const
+{
+    if (start_height < 0) {
+        return error("%s: start height (%d) is negative", __func__, start_height);
+    }
+    if (start_height > stop_index->nHeight) {
+        return error("%s: start height (%d) is greater than stop height (%d)",
+                     __func__, start_height, stop_index->nHeight);
+    }
+
+    size_t results_size = static_cast<size_t>(stop_index->nHeight - start_height + 1);
+    std::vector<ViewTagEntries> values(results_size);
+
+    DBHeightKey key(start_height);
+    std::unique_ptr<CDBIterator> db_it(m_db->NewIterator());
+    db_it->Seek(DBHeightKey(start_height));
+    for (int height = start_height; height <= stop_index->nHeight; ++height) {
+        if (!db_it->Valid() || !db_it->GetKey(key) || key.height != height) {
+            return false;
+        }
+
+        size_t i = static_cast<size_t>(height - start_height);
+        if (!db_it->GetValue(values[i])) {
+            return error("%s: unable to read value in %s at key (%c, %d)",
+                         __func__, GetName(), DB_VIEWTAG_HEIGHT, height);
+        }
+
+        db_it->Next();
+    }
+
+    // Walk back from the stop block to make sure every entry belongs to the
+    // requested chain rather than to a block that has since been reorged out.
+    for (const CBlockIndex* block_index = stop_index;
+         block_index && block_index->nHeight >= start_height;
+         block_index = block_index->pprev) {
+        size_t i = static_cast<size_t>(block_index->nHeight - start_height);
+        if (values[i].block_hash != block_index->GetBlockHash()) {
+            return false;
+        }
+    }
+
+    entries = std::move(values);
+    return true;
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2024 The Navio developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INDEX_VIEWTAGINDEX_H
+#define BITCOIN_INDEX_VIEWTAGINDEX_H
+
+#include <blsct/arith/mcl/mcl_g1point.h>
+#include <index/base.h>
+#include <primitives/transaction.h>
+#include <serialize.h>
+#include <uint256.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class CBlockIndex;
+
+static constexpr bool DEFAULT_VIEWTAGINDEX{false};
+
+/** Maximum number of blocks that can be looked up through RPC or REST at once */
+static constexpr int MAX_VIEWTAG_LOOKUP_RANGE{2000};
+
+/**
+ * The BLSCT outputs of a single block, stored column by column so that a
+ * scanner can test every view tag before touching any of the keys.
+ *
+ * Points are kept in their serialized form: they were validated when the
+ * block was connected and decoding them again is left to the reader.
+ */
+struct ViewTagEntries {
+    using PointBytes = std::array<uint8_t, MclG1Point::SERIALIZATION_SIZE>;
+
+    uint256 block_hash;
+    std::vector<uint16_t> view_tags;
+    std::vector<PointBytes> blinding_keys;
+    std::vector<COutPoint> outpoints;
+    std::vector<PointBytes> spending_keys;
+
+    size_t size() const { return view_tags.size(); }
+
+    SERIALIZE_METHODS(ViewTagEntries, obj)
+    {
+        READWRITE(obj.block_hash, obj.view_tags, obj.blinding_keys, obj.outpoints, obj.spending_keys);
+    }
+};
+
+/**
+ * ViewTagIndex records, for every block, the view tag, blinding key,
+ * outpoint and spending key of each BLSCT output. This is all a wallet
+ * needs to find its outputs, so servers scanning for many view keys can
+ * avoid reading full blocks and their range proofs.
+ */
+class ViewTagIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+    bool AllowPrune() const override { return false; }
+
+protected:
+    /** Encode the outputs of the block, which does not depend on earlier blocks. */
+    std::any CustomPrepare(const interfaces::BlockInfo& block) const override;
+
+    bool CustomAppendPrepared(const interfaces::BlockInfo& block, std::any&& prepared) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit ViewTagIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~ViewTagIndex() override;
+
+    /// Look up the BLSCT outputs of every block from start_height up to and
+    /// including stop_index. Returns false if any block in the range is not
+    /// indexed or the index has not caught up with a reorg yet.
+    bool LookUpViewTags(int start_height, const CBlockIndex* stop_index, std::vector<ViewTagEntries>& entries) const;
+};
+
+/// The global view tag index. May be null.
+extern std::unique_ptr<ViewTagIndex> g_viewtagindex;
+
+#endif // BITCOIN_INDEX_VIEWTAGINDEX_H
@@ -25,6 +25,7 @@ class CFeeRate;
 class CRPCCommand;
 class CScheduler;
 class Coin;
+class MclScalar;
 class uint256;
 enum class MemPoolRemovalReason;
 enum class RBFTransactionState;
@@ -32,6 +33,9 @@ enum class ChainstateRole;
 struct bilingual_str;
 struct CBlockLocator;
 struct FeeCalculation;
+namespace blsct {
+class SubAddress;
+} // namespace blsct
 namespace node {
 struct NodeContext;
 } // namespace node
@@ -215,6 +219,11 @@ public:
         bool relay,
         std::string& err_string) = 0;
 
+    //! Try to stake a block on the current tip with one of the given staked
+    //! commitments, as (value, gamma) pairs, paying the reward to destination.
+    //! Return the hash of the block if one was found and accepted.
+    virtual std::optional<uint256> stakeBlock(const std::vector<std::pair<MclScalar, MclScalar>>& commitments, const blsct::SubAddress& destination) = 0;
+
     //! Calculate mempool ancestor and descendant counts for the given transaction.
     virtual void getTransactionAncestry(const uint256& txid, size_t& ancestors, size_t& descendants, size_t* ancestorsize = nullptr, CAmount* ancestorfees = nullptr) = 0;
 
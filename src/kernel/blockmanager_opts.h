@@ -8,10 +8,14 @@
 #include <kernel/notifications_interface.h>
 #include <util/fs.h>
 
+#include <cstddef>
 #include <cstdint>
 
 class CChainParams;
 
+/** Default for -blockcachesize, memory (in MiB) for caching recently read blocks */
+static constexpr unsigned int DEFAULT_BLOCK_CACHE_SIZE_MB{32};
+
 namespace kernel {
 
 /**
@@ -22,6 +26,7 @@ struct BlockManagerOpts {
     const CChainParams& chainparams;
     uint64_t prune_target{0};
     bool fast_prune{false};
+    size_t block_cache_size{DEFAULT_BLOCK_CACHE_SIZE_MB * 1024 * 1024};
     const fs::path blocks_dir;
     Notifications& notifications;
 };
@@ -5,6 +5,7 @@
 #include <kernel/coinstats.h>
 
 #include <chain.h>
+#include <checkqueue.h>
 #include <coins.h>
 #include <crypto/muhash.h>
 #include <hash.h>
@@ -22,16 +23,22 @@
 #include <util/overflow.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iosfwd>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace kernel {
 
+//! Upper bound on the worker threads hashing the UTXO set into a MuHash
+static constexpr int MAX_COIN_HASH_THREADS{8};
+
 CCoinsStats::CCoinsStats(int block_height, const uint256& block_hash)
     : nHeight(block_height),
       hashBlock(block_hash) {}
@@ -76,6 +83,104 @@ void RemoveCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& c
 
 static void ApplyCoinHash(std::nullptr_t, const COutPoint& outpoint, const Coin& coin) {}
 
+namespace {
+
+/** A MuHash3072 the coin hash checks multiply their partial products into */
+struct SharedMuHash {
+    Mutex m_mutex;
+    MuHash3072 m_muhash GUARDED_BY(m_mutex);
+
+    void Combine(const MuHash3072& partial) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_muhash *= partial;
+    }
+};
+
+/** Hashes a batch of coins into a MuHash3072 on a check queue worker */
+class CCoinHashCheck
+{
+private:
+    std::vector<std::pair<COutPoint, Coin>> m_coins;
+    SharedMuHash* m_muhash;
+
+public:
+    CCoinHashCheck(std::vector<std::pair<COutPoint, Coin>>&& coins, SharedMuHash& muhash) : m_coins(std::move(coins)), m_muhash(&muhash) {}
+
+    bool operator()()
+    {
+        MuHash3072 partial;
+        for (const auto& [outpoint, coin] : m_coins) {
+            ApplyCoinHash(partial, outpoint, coin);
+        }
+        m_muhash->Combine(partial);
+        return true;
+    }
+};
+
+/**
+ * Accumulates coins into a MuHash3072 on the workers of a check queue. The
+ * cursor over the UTXO set is read on the calling thread and handed over in
+ * batches, and the partial product of each batch is multiplied into the
+ * result. This works because MuHash does not depend on the order coins are
+ * added in.
+ */
+class ParallelMuHash
+{
+    //! Number of coins hashed by one check
+    static constexpr size_t BATCH_SIZE{1000};
+    //! Number of checks queued before the calling thread waits for them
+    static constexpr size_t MAX_QUEUED_CHECKS{64};
+
+    std::vector<std::pair<COutPoint, Coin>> m_batch;
+    size_t m_queued{0};
+    SharedMuHash m_muhash;
+    // Declared last, so that its workers are joined before the state they use goes away
+    CCheckQueue<CCoinHashCheck> m_queue;
+
+    void Flush()
+    {
+        if (m_batch.empty()) return;
+        std::vector<CCoinHashCheck> checks;
+        checks.emplace_back(std::move(m_batch), m_muhash);
+        m_queue.Add(std::move(checks));
+        m_batch.clear();
+        m_batch.reserve(BATCH_SIZE);
+        // Bound the coins held in memory by helping with the queued checks
+        if (++m_queued >= MAX_QUEUED_CHECKS) {
+            m_queue.Wait();
+            m_queued = 0;
+        }
+    }
+
+public:
+    explicit ParallelMuHash(int worker_threads_num) : m_queue{/*batch_size=*/1, worker_threads_num}
+    {
+        m_batch.reserve(BATCH_SIZE);
+    }
+
+    void Apply(const COutPoint& outpoint, Coin&& coin)
+    {
+        m_batch.emplace_back(outpoint, std::move(coin));
+        if (m_batch.size() >= BATCH_SIZE) Flush();
+    }
+
+    void Finalize(uint256& out)
+    {
+        Flush();
+        m_queue.Wait();
+        LOCK(m_muhash.m_mutex);
+        m_muhash.m_muhash.Finalize(out);
+    }
+};
+
+} // namespace
+
+static void ApplyCoinHash(ParallelMuHash& muhash, const COutPoint& outpoint, Coin&& coin)
+{
+    muhash.Apply(outpoint, std::move(coin));
+}
+
 //! Warning: be very careful when changing this! assumeutxo and UTXO snapshot
 //! validation commitments are reliant on the hash constructed by this
 //! function.
@@ -89,12 +194,11 @@ static void ApplyCoinHash(std::nullptr_t, const COutPoint& outpoint, const Coin&
 //! construction could cause a previously invalid (and potentially malicious)
 //! UTXO snapshot to be considered valid.
 template <typename T>
-static void ApplyHash(T& hash_obj, const Txid& hash, const std::map<uint32_t, Coin>& outputs)
+static void ApplyHash(T& hash_obj, const Txid& hash, std::map<uint32_t, Coin>& outputs)
 {
     for (auto it = outputs.begin(); it != outputs.end(); ++it) {
         COutPoint outpoint = COutPoint(hash, it->first);
-        Coin coin = it->second;
-        ApplyCoinHash(hash_obj, outpoint, coin);
+        ApplyCoinHash(hash_obj, outpoint, std::move(it->second));
     }
 }
 
@@ -113,7 +217,7 @@ static void ApplyStats(CCoinsStats& stats, const uint256& hash, const std::map<u
 
 //! Calculate statistics about the unspent transaction output set
 template <typename T>
-static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, const std::function<void()>& interruption_point)
+static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T&& hash_obj, const std::function<void()>& interruption_point)
 {
     std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
     assert(pcursor);
@@ -162,7 +266,7 @@ std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsV
             return ComputeUTXOStats(view, stats, ss, interruption_point);
         }
         case(CoinStatsHashType::MUHASH): {
-            MuHash3072 muhash;
+            ParallelMuHash muhash{std::clamp<int>(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1, MAX_COIN_HASH_THREADS)};
             return ComputeUTXOStats(view, stats, muhash, interruption_point);
         }
         case(CoinStatsHashType::NONE): {
@@ -188,6 +292,12 @@ static void FinalizeHash(MuHash3072& muhash, CCoinsStats& stats)
     muhash.Finalize(out);
     stats.hashSerialized = out;
 }
+static void FinalizeHash(ParallelMuHash& muhash, CCoinsStats& stats)
+{
+    uint256 out;
+    muhash.Finalize(out);
+    stats.hashSerialized = out;
+}
 static void FinalizeHash(std::nullptr_t, CCoinsStats& stats) {}
 
 } // namespace kernel
@@ -4,6 +4,7 @@
 
 #include <kernel/mempool_persist.h>
 
+#include <checkqueue.h>
 #include <clientversion.h>
 #include <consensus/amount.h>
 #include <logging.h>
@@ -20,6 +21,7 @@
 #include <util/time.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <exception>
@@ -38,6 +40,16 @@ namespace kernel {
 static const uint64_t MEMPOOL_DUMP_VERSION_NO_XOR_KEY{1};
 static const uint64_t MEMPOOL_DUMP_VERSION{2};
 
+//! Number of transactions read from the dump whose range proofs are verified together
+static const size_t MEMPOOL_LOAD_BATCH_SIZE{1000};
+
+struct PersistedTx {
+    CTransactionRef tx;
+    int64_t nTime;
+    int64_t nEmbargo;
+    int64_t nFeeDelta;
+};
+
 bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active_chainstate, ImportMempoolOptions&& opts)
 {
     if (load_path.empty()) return false;
@@ -72,53 +84,83 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
         uint64_t txns_tried = 0;
         LogInfo("Loading %u mempool transactions from disk...\n", total_txns_to_load);
         int next_tenth_to_report = 0;
+        const CAmount min_stake{active_chainstate.m_chainman.GetConsensus().nPePoSMinStakeAmount};
         while (txns_tried < total_txns_to_load) {
-            const int percentage_done(100.0 * txns_tried / total_txns_to_load);
-            if (next_tenth_to_report < percentage_done / 10) {
-                LogInfo("Progress loading mempool transactions from disk: %d%% (tried %u, %u remaining)\n",
-                        percentage_done, txns_tried, total_txns_to_load - txns_tried);
-                next_tenth_to_report = percentage_done / 10;
-            }
-            ++txns_tried;
-
-            CTransactionRef tx;
-            int64_t nTime;
-            int64_t nEmbargo;
-            int64_t nFeeDelta;
-            file >> TX_WITH_WITNESS(tx);
-            file >> nTime;
-            file >> nEmbargo;
-            file >> nFeeDelta;
-
-            if (opts.use_current_time) {
-                nTime = TicksSinceEpoch<std::chrono::seconds>(now);
+            // Read the next batch of transactions and verify their range
+            // proofs on the worker threads before any lock is taken, so
+            // that accepting them below only checks what depends on the
+            // coins they spend. The dump is written in dependency order,
+            // which is kept when submitting them.
+            std::vector<PersistedTx> batch;
+            batch.reserve(std::min<uint64_t>(MEMPOOL_LOAD_BATCH_SIZE, total_txns_to_load - txns_tried));
+            // If the dump ends early, the transactions read before are still
+            // submitted, as if they had been read one by one.
+            std::exception_ptr read_error;
+            try {
+                while (batch.size() < MEMPOOL_LOAD_BATCH_SIZE && txns_tried + batch.size() < total_txns_to_load) {
+                    PersistedTx entry;
+                    file >> TX_WITH_WITNESS(entry.tx);
+                    file >> entry.nTime;
+                    file >> entry.nEmbargo;
+                    file >> entry.nFeeDelta;
+                    batch.push_back(std::move(entry));
+                }
+            } catch (const std::exception&) {
+                read_error = std::current_exception();
             }
 
-            CAmount amountdelta = nFeeDelta;
-            if (amountdelta && opts.apply_fee_delta_priority) {
-                pool.PrioritiseTransaction(tx->GetHash(), amountdelta);
+            {
+                std::vector<CBLSCTCheck> checks;
+                for (const auto& entry : batch) {
+                    if (entry.tx->IsBLSCT()) checks.emplace_back(entry.tx, min_stake);
+                }
+                // Failures are not reported here: transactions whose proofs
+                // are not cached get verified again (and rejected) below.
+                CCheckQueueControl<CBLSCTCheck> control(&active_chainstate.m_chainman.GetBLSCTCheckQueue());
+                control.Add(std::move(checks));
+                control.Wait();
             }
-            if (nTime > TicksSinceEpoch<std::chrono::seconds>(now - pool.m_expiry)) {
-                LOCK(cs_main);
-                const auto& accepted = AcceptToMemoryPool(active_chainstate, tx, nTime, nEmbargo, /*bypass_limits=*/false, /*test_accept=*/false);
-                if (accepted.m_result_type == MempoolAcceptResult::ResultType::VALID) {
-                    ++count;
-                } else {
-                    // mempool may contain the transaction already, e.g. from
-                    // wallet(s) having loaded it while we were processing
-                    // mempool transactions; consider these as valid, instead of
-                    // failed, but mark them as 'already there'
-                    if (pool.exists(GenTxid::Txid(tx->GetHash()))) {
-                        ++already_there;
+
+            for (auto& [tx, nTime, nEmbargo, nFeeDelta] : batch) {
+                const int percentage_done(100.0 * txns_tried / total_txns_to_load);
+                if (next_tenth_to_report < percentage_done / 10) {
+                    LogInfo("Progress loading mempool transactions from disk: %d%% (tried %u, %u remaining)\n",
+                            percentage_done, txns_tried, total_txns_to_load - txns_tried);
+                    next_tenth_to_report = percentage_done / 10;
+                }
+                ++txns_tried;
+
+                if (opts.use_current_time) {
+                    nTime = TicksSinceEpoch<std::chrono::seconds>(now);
+                }
+
+                CAmount amountdelta = nFeeDelta;
+                if (amountdelta && opts.apply_fee_delta_priority) {
+                    pool.PrioritiseTransaction(tx->GetHash(), amountdelta);
+                }
+                if (nTime > TicksSinceEpoch<std::chrono::seconds>(now - pool.m_expiry)) {
+                    LOCK(cs_main);
+                    const auto& accepted = AcceptToMemoryPool(active_chainstate, tx, nTime, nEmbargo, /*bypass_limits=*/false, /*test_accept=*/false);
+                    if (accepted.m_result_type == MempoolAcceptResult::ResultType::VALID) {
+                        ++count;
                     } else {
-                        ++failed;
+                        // mempool may contain the transaction already, e.g. from
+                        // wallet(s) having loaded it while we were processing
+                        // mempool transactions; consider these as valid, instead of
+                        // failed, but mark them as 'already there'
+                        if (pool.exists(GenTxid::Txid(tx->GetHash()))) {
+                            ++already_there;
+                        } else {
+                            ++failed;
+                        }
                     }
+                } else {
+                    ++expired;
                 }
-            } else {
-                ++expired;
+                if (active_chainstate.m_chainman.m_interrupt)
+                    return false;
             }
-            if (active_chainstate.m_chainman.m_interrupt)
-                return false;
+            if (read_error) std::rethrow_exception(read_error);
         }
         std::map<uint256, CAmount> mapDeltas;
         file >> mapDeltas;
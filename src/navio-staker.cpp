@@ -33,14 +33,18 @@
 #include <util/translation.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #ifndef WIN32
 #include <unistd.h>
@@ -57,6 +61,8 @@ static const int DEFAULT_HTTP_CLIENT_TIMEOUT = 900;
 static constexpr int DEFAULT_WAIT_CLIENT_TIMEOUT = 0;
 static const int CONTINUE_EXECUTION = -1;
 static const char* const DEFAULT_LOGFILE = "staker.log";
+/** Default number of staking threads, 0 = one per core */
+static constexpr int DEFAULT_STAKE_THREADS = 0;
 
 /** Default -color setting. */
 static const std::string DEFAULT_COLOR_SETTING{"auto"};
@@ -91,6 +97,7 @@ static void SetupCliArgs(ArgsManager& argsman)
     argsman.AddArg("-stdinwalletpassphrase", "Read wallet passphrase from standard input as a single line. When combined with -stdin, the first line from standard input is used for the wallet passphrase.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-wallet=<wallet-name>", "Specify wallet name", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-walletpassphrase=<password>", "Specify the password to unlock the wallet", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-stakethreads=<n>", strprintf("Number of threads used to evaluate staked commitments and build proofs of stake (0 = one per core, default: %d)", DEFAULT_STAKE_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-coinbasedest=<address>", "Specify the address to collect the staking rewards", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::OPTIONS);
 }
 
@@ -435,6 +442,7 @@ static std::string walletPassphrase;
 static std::string coinbase_dest;
 static bool mustUnlockWallet = false;
 static arith_uint256 currentDifficulty;
+static int stakeThreads = 1;
 
 util::Result<void> SetLoggingCategories(const ArgsManager& args)
 {
@@ -504,6 +512,9 @@ void Setup()
     if (gArgs.IsArgSet("-coinbasedest"))
         coinbase_dest = gArgs.GetArg("-coinbasedest", {});
 
+    stakeThreads = gArgs.GetIntArg("-stakethreads", DEFAULT_STAKE_THREADS);
+    if (stakeThreads <= 0) stakeThreads = std::max(GetNumCores(), 1);
+
     if (gArgs.IsArgSet("-wallet")) walletName = gArgs.GetArg("-wallet", {});
 
     if (walletName == "")
@@ -723,9 +734,18 @@ std::vector<StakedCommitment> GetStakedCommitments(const std::unique_ptr<BaseReq
     return UniValueArrayToStakedCommitmentsMine(result.get_array());
 }
 
-std::optional<CBlock> GetBlockProposal(const std::unique_ptr<BaseRequestHandler>& rh, const StakedCommitment& staked_commitment)
+struct StakingTemplate {
+    CBlock block;
+    Points staked_elements;
+    MclScalar eta_fiat_shamir;
+    blsct::Message eta_phi;
+    uint32_t prev_time;
+    uint64_t modifier;
+};
+
+std::optional<StakingTemplate> GetStakingTemplate(const std::unique_ptr<BaseRequestHandler>& rh)
 {
-    CBlock proposal;
+    StakingTemplate tmpl;
 
     auto reply = ConnectAndCallRPC(rh.get(), "getblocktemplate", /* args=*/{"{\"rules\": [\"\"], \"coinbasedest\": \"" + coinbase_dest + "\"}"}, walletName);
     const UniValue& result = reply.find_value("result");
@@ -743,35 +763,107 @@ std::optional<CBlock> GetBlockProposal(const std::unique_ptr<BaseRequestHandler>
         return std::nullopt;
     }
 
-    auto eta_fiat_shamir = ParseHex(result.find_value("eta_fiat_shamir").get_str());
-    auto eta_phi = ParseHex(result.find_value("eta_phi").get_str());
-
-    MclScalar m = staked_commitment.value;
-    MclScalar f = staked_commitment.gamma;
+    tmpl.eta_fiat_shamir = ParseHex(result.find_value("eta_fiat_shamir").get_str());
+    tmpl.eta_phi = ParseHex(result.find_value("eta_phi").get_str());
 
-    uint32_t prev_time = result.find_value("prev_time").get_real();
-    uint64_t modifier = result.find_value("modifier").get_uint64();
+    tmpl.prev_time = result.find_value("prev_time").get_real();
+    tmpl.modifier = result.find_value("modifier").get_uint64();
     uint64_t next_target = stoi(result.find_value("bits").get_str(), nullptr, 16);
     currentDifficulty.SetCompact(next_target);
 
-    proposal.nVersion = result.find_value("version").get_real();
-    proposal.nTime = result.find_value("curtime").get_real();
-    proposal.nBits = next_target;
-    proposal.hashPrevBlock = uint256S(result.find_value("previousblockhash").get_str());
-    proposal.vtx = UniValueArrayToTransactions(result.find_value("transactions").get_array());
+    tmpl.block.nVersion = result.find_value("version").get_real();
+    tmpl.block.nTime = result.find_value("curtime").get_real();
+    tmpl.block.nBits = next_target;
+    tmpl.block.hashPrevBlock = uint256S(result.find_value("previousblockhash").get_str());
+    tmpl.block.vtx = UniValueArrayToTransactions(result.find_value("transactions").get_array());
+
+    tmpl.staked_elements = UniValueArrayToStakedCommitments(result.find_value("staked_commitments").get_array());
+
+    return tmpl;
+}
+
+/** Run fn(i) for every i in [0, count) on up to stakeThreads threads, until stop is set */
+template <typename F>
+void ParallelFor(size_t count, const std::atomic<bool>& stop, F fn)
+{
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < count && !stop; i = next++) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const size_t n_threads = std::min<size_t>(stakeThreads, count);
+    for (size_t i = 1; i < n_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
 
-    auto staked_elements = UniValueArrayToStakedCommitments(result.find_value("staked_commitments").get_array());
+std::optional<CBlock> GetBlockProposal(const StakingTemplate& tmpl, const StakedCommitment& staked_commitment)
+{
+    CBlock proposal = tmpl.block;
 
-    proposal.posProof = blsct::ProofOfStake(staked_elements, eta_fiat_shamir, eta_phi, m, f, prev_time, modifier, proposal.nTime, next_target);
+    proposal.posProof = blsct::ProofOfStake(tmpl.staked_elements, tmpl.eta_fiat_shamir, tmpl.eta_phi, staked_commitment.value, staked_commitment.gamma, tmpl.prev_time, tmpl.modifier, proposal.nTime, proposal.nBits);
     proposal.hashMerkleRoot = BlockMerkleRoot(proposal);
 
-    auto valid = blsct::ProofOfStake(proposal.posProof).Verify(staked_elements, eta_fiat_shamir, eta_phi, blsct::CalculateKernelHash(prev_time, modifier, proposal.posProof.setMemProof.phi, proposal.nTime), next_target);
+    auto valid = proposal.posProof.Verify(tmpl.staked_elements, tmpl.eta_fiat_shamir, tmpl.eta_phi, blsct::CalculateKernelHash(tmpl.prev_time, tmpl.modifier, proposal.posProof.setMemProof.phi, proposal.nTime), proposal.nBits);
 
     if (valid == blsct::ProofOfStake::VALID) return proposal;
 
     return std::nullopt;
 }
 
+/**
+ * Evaluate the kernel of every staked commitment against a single template,
+ * and only build proofs of stake for the commitments whose kernel meets the
+ * target. Both steps are spread over the staking threads; the first valid
+ * proposal wins.
+ */
+std::optional<CBlock> FindBlockProposal(const StakingTemplate& tmpl, const std::vector<StakedCommitment>& staked_commitments)
+{
+    const auto start{SteadyClock::now()};
+
+    std::vector<char> eligible(staked_commitments.size(), false);
+    std::atomic<bool> stop{false};
+
+    ParallelFor(staked_commitments.size(), stop, [&](size_t i) {
+        const auto& commitment = staked_commitments[i];
+        const auto kernel_start{SteadyClock::now()};
+        auto phi = blsct::ProofOfStake::CalculatePhi(tmpl.eta_phi, commitment.value, commitment.gamma);
+        auto kernel_hash = blsct::CalculateKernelHash(tmpl.prev_time, tmpl.modifier, phi, tmpl.block.nTime);
+        eligible[i] = blsct::ProofOfStake::IsKernelEligible(commitment.value, kernel_hash, tmpl.block.nBits);
+        LogPrint(BCLog::BENCH, "%s: [%s] Commitment %s kernel %s in %.2fms\n", __func__, walletName, HexStr(commitment.point.GetVch()).substr(0, 16), eligible[i] ? "eligible" : "not eligible", Ticks<MillisecondsDouble>(SteadyClock::now() - kernel_start));
+    });
+
+    std::vector<size_t> winners;
+    for (size_t i = 0; i < eligible.size(); ++i) {
+        if (eligible[i]) winners.push_back(i);
+    }
+
+    LogPrint(BCLog::BENCH, "%s: [%s] Evaluated %u commitments (%u eligible) in %.2fms\n", __func__, walletName, staked_commitments.size(), winners.size(), Ticks<MillisecondsDouble>(SteadyClock::now() - start));
+
+    std::optional<CBlock> proposal;
+    std::mutex proposal_mutex;
+
+    ParallelFor(winners.size(), stop, [&](size_t i) {
+        const auto& commitment = staked_commitments[winners[i]];
+        const auto proof_start{SteadyClock::now()};
+        auto candidate = GetBlockProposal(tmpl, commitment);
+        LogPrint(BCLog::BENCH, "%s: [%s] Commitment %s proof %s in %.2fms\n", __func__, walletName, HexStr(commitment.point.GetVch()).substr(0, 16), candidate ? "valid" : "invalid", Ticks<MillisecondsDouble>(SteadyClock::now() - proof_start));
+        if (!candidate) return;
+        std::lock_guard<std::mutex> lock(proposal_mutex);
+        if (!proposal) proposal = std::move(candidate);
+        stop = true;
+    });
+
+    return proposal;
+}
+
 
 void Loop()
 {
@@ -783,28 +875,24 @@ void Loop()
     auto start{SteadyClock::now()};
     double nFound = 0;
 
-    LogPrintf("%s: [%s] Starting staking...\n", __func__, walletName);
+    LogPrintf("%s: [%s] Starting staking with %d threads...\n", __func__, walletName, stakeThreads);
 
     while (true) {
         auto staked_commitments = GetStakedCommitments(rh);
-        CBlock proposal;
         CAmount nTotalMoney = 0;
-        bool found = false;
 
         for (auto& it : staked_commitments) {
             nTotalMoney += it.value.GetUint64();
+        }
 
-            if (!found) {
-                auto candidate = GetBlockProposal(rh, it);
-
-                found = candidate.has_value();
-                if (found)
-                    proposal = candidate.value();
-            }
+        std::optional<CBlock> proposal;
+        if (!staked_commitments.empty()) {
+            auto tmpl = GetStakingTemplate(rh);
+            if (tmpl) proposal = FindBlockProposal(*tmpl, staked_commitments);
         }
 
-        if (found) {
-            const UniValue& reply_submit = ConnectAndCallRPC(rh.get(), "submitblock", /* args=*/{EncodeHexBlock(proposal)}, walletName);
+        if (proposal) {
+            const UniValue& reply_submit = ConnectAndCallRPC(rh.get(), "submitblock", /* args=*/{EncodeHexBlock(*proposal)}, walletName);
 
             const UniValue& result_submit = reply_submit.find_value("result");
             const UniValue& error_submit = reply_submit.find_value("error");
@@ -814,7 +902,7 @@ void Loop()
                     nFound++;
                     last_update = SteadyClock::now();
                 }
-                LogPrintf("%s: [%s] Found block %s (%s%s). Current difficulty: %s\n", __func__, walletName, proposal.GetHash().ToString(), result_submit.isNull() ? "ACCEPTED" : "REJECTED: ", result_submit.isNull() ? "" : reply_submit.write(0, 0), currentDifficulty.ToString());
+                LogPrintf("%s: [%s] Found block %s (%s%s). Current difficulty: %s\n", __func__, walletName, proposal->GetHash().ToString(), result_submit.isNull() ? "ACCEPTED" : "REJECTED: ", result_submit.isNull() ? "" : reply_submit.write(0, 0), currentDifficulty.ToString());
 
                 auto elapsed = Ticks<std::chrono::minutes>(SteadyClock::now() - start);
 
@@ -176,6 +176,10 @@ static constexpr double MAX_ADDR_RATE_PER_SECOND{0.1};
 static constexpr size_t MAX_ADDR_PROCESSING_TOKEN_BUCKET{MAX_ADDR_TO_SEND};
 /** The compactblocks version we support. See BIP 152. */
 static constexpr uint64_t CMPCTBLOCKS_VERSION{2};
+/** Version of compact blocks which, for BLSCT blocks, carry the short ids of
+ *  the transactions aggregated into the block instead of the aggregated one.
+ *  Announced in addition to CMPCTBLOCKS_VERSION, which it extends. */
+static constexpr uint64_t CMPCTBLOCKS_BLSCT_VERSION{3};
 
 // Internal stuff
 namespace {
@@ -286,6 +290,16 @@ struct Peer {
         bool m_send_mempool GUARDED_BY(m_tx_inventory_mutex){false};
         /** Whether the peer has been selected as a Dandelion++ stem peer */
         bool m_send_stem GUARDED_BY(m_tx_inventory_mutex){false};
+        /** Stem transactions (txid or wtxid, as above) we still have to
+         *  announce along this Dandelion++ route, with the time they were
+         *  queued. They are sent as one batch on their own timer. */
+        std::map<uint256, std::chrono::microseconds> m_stem_inventory_to_send GUARDED_BY(m_tx_inventory_mutex);
+        /** The next time after which we will announce queued stem transactions */
+        std::chrono::microseconds m_next_stem_send_time GUARDED_BY(m_tx_inventory_mutex){0};
+        /** Number of stem transactions announced along this route */
+        uint64_t m_stem_txs_sent GUARDED_BY(m_tx_inventory_mutex){0};
+        /** Total time those transactions waited in m_stem_inventory_to_send */
+        std::chrono::microseconds m_stem_latency_total GUARDED_BY(m_tx_inventory_mutex){0};
         /** The last time a BIP35 `mempool` request was serviced. */
         std::atomic<std::chrono::seconds> m_last_mempool_req{0s};
         /** The next time after which we will send an `inv` message containing
@@ -434,6 +448,8 @@ struct CNodeState {
     bool m_requested_hb_cmpctblocks{false};
     /** Whether this peer will send us cmpctblocks if we request them. */
     bool m_provides_cmpctblocks{false};
+    /** Whether this peer sends and understands cmpctblocks of CMPCTBLOCKS_BLSCT_VERSION. */
+    bool m_provides_blsct_cmpctblocks{false};
 
     /** State used to enforce CHAIN_SYNC_TIMEOUT and EXTRA_PEER_CHECK_INTERVAL logic.
       *
@@ -490,7 +506,7 @@ public:
 
     /** Overridden from CValidationInterface. */
     void BlockConnected(ChainstateRole role, const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexConnected) override
-        EXCLUSIVE_LOCKS_REQUIRED(!m_recent_confirmed_transactions_mutex);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_stempool_mutex);
     void BlockDisconnected(const std::shared_ptr<const CBlock> &block, const CBlockIndex* pindex) override
         EXCLUSIVE_LOCKS_REQUIRED(!m_recent_confirmed_transactions_mutex);
     void UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, bool fInitialDownload) override
@@ -499,14 +515,18 @@ public:
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     void NewPoWValidBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& pblock) override
         EXCLUSIVE_LOCKS_REQUIRED(!m_most_recent_block_mutex);
+    void TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) override
+        EXCLUSIVE_LOCKS_REQUIRED(!m_stempool_mutex);
+    void MempoolTransactionsRemovedForBlock(const std::vector<RemovedMempoolTransactionInfo>& txs_removed_for_block, unsigned int nBlockHeight) override
+        EXCLUSIVE_LOCKS_REQUIRED(!m_stempool_mutex);
 
     /** Implement NetEventsInterface */
     void InitializeNode(CNode& node, ServiceFlags our_services) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     void FinalizeNode(const CNode& node) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_headers_presync_mutex);
     bool ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt) override
-        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex, g_msgproc_mutex);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex, !m_stempool_mutex, g_msgproc_mutex);
     bool SendMessages(CNode* pto) override
-        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, g_msgproc_mutex);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_stempool_mutex, g_msgproc_mutex);
     void ShuffleStemRoutes(const std::vector<CNode*>& nodes) override
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, g_msgproc_mutex);
 
@@ -518,12 +538,13 @@ public:
     bool GetNodeStateStats(NodeId nodeid, CNodeStateStats& stats) const override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     bool IgnoresIncomingTxs() override { return m_opts.ignore_incoming_txs; }
     void SendPings() override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
-    void RelayTransaction(const uint256& txid, const uint256& wtxid) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+    void RelayTransaction(const uint256& txid, const uint256& wtxid) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_stempool_mutex);
+    StempoolStats GetStempoolStats() override EXCLUSIVE_LOCKS_REQUIRED(!m_stempool_mutex);
     void SetBestHeight(int height) override { m_best_height = height; };
     void UnitTestMisbehaving(NodeId peer_id, int howmuch) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex) { Misbehaving(*Assert(GetPeerRef(peer_id)), howmuch, ""); };
     void ProcessMessage(CNode& pfrom, const std::string& msg_type, DataStream& vRecv,
                         const std::chrono::microseconds time_received, const std::atomic<bool>& interruptMsgProc) override
-        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex, g_msgproc_mutex);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex, !m_stempool_mutex, g_msgproc_mutex);
     void UpdateLastBlockAnnounceTime(NodeId node, int64_t time_in_seconds) override;
 
 private:
@@ -734,6 +755,41 @@ private:
     /** Next time to shuffle stem routes */
     std::chrono::microseconds m_next_stem_peer_shuffle = 0s;
 
+    /** A Dandelion++ transaction in stem phase, only announced to stem peers
+     *  until its embargo ends. */
+    struct StemTx {
+        std::chrono::microseconds m_embargo;
+        uint256 m_txid;
+        uint256 m_wtxid;
+        int32_t m_vsize;
+    };
+    struct StemTxEmbargoLater {
+        bool operator()(const StemTx& a, const StemTx& b) const { return a.m_embargo > b.m_embargo; }
+    };
+
+    Mutex m_stempool_mutex;
+    /** Transactions in stem phase, as a heap with the earliest embargo end on top */
+    std::vector<StemTx> m_stempool GUARDED_BY(m_stempool_mutex);
+    /** Txids and wtxids of the transactions in m_stempool */
+    std::set<uint256> m_stempool_hashes GUARDED_BY(m_stempool_mutex);
+    /** Total virtual size of the transactions in m_stempool */
+    int64_t m_stempool_vsize GUARDED_BY(m_stempool_mutex){0};
+
+    /** Whether a transaction, by txid or wtxid, is in stem phase */
+    bool IsStemTransaction(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_stempool_mutex)
+    {
+        return WITH_LOCK(m_stempool_mutex, return m_stempool_hashes.count(hash) > 0);
+    }
+
+    /** Queue a transaction for announcement to every peer, or only to stem peers */
+    void QueueTransaction(const uint256& txid, const uint256& wtxid, bool stem_only) EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+
+    /** Announce the transactions whose embargo has ended to every peer */
+    void FluffStemTransactions(std::chrono::microseconds now) EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_stempool_mutex);
+
+    /** Drop the transactions with the given wtxids from the stempool */
+    void EraseStemTransactions(const std::set<uint256>& wtxids) EXCLUSIVE_LOCKS_REQUIRED(!m_stempool_mutex);
+
     const Options m_opts;
 
     bool RejectIncomingTxs(const CNode& peer) const;
@@ -863,6 +919,8 @@ private:
     Mutex m_most_recent_block_mutex;
     std::shared_ptr<const CBlock> m_most_recent_block GUARDED_BY(m_most_recent_block_mutex);
     std::shared_ptr<const CBlockHeaderAndShortTxIDs> m_most_recent_compact_block GUARDED_BY(m_most_recent_block_mutex);
+    //! m_most_recent_compact_block for peers of CMPCTBLOCKS_BLSCT_VERSION
+    std::shared_ptr<const CBlockHeaderAndShortTxIDs> m_most_recent_blsct_compact_block GUARDED_BY(m_most_recent_block_mutex);
     uint256 m_most_recent_block_hash GUARDED_BY(m_most_recent_block_mutex);
     std::unique_ptr<const std::map<uint256, CTransactionRef>> m_most_recent_block_txs GUARDED_BY(m_most_recent_block_mutex);
 
@@ -1712,6 +1770,12 @@ bool PeerManagerImpl::GetNodeStateStats(NodeId nodeid, CNodeStateStats& stats) c
     if (auto tx_relay = peer->GetTxRelay(); tx_relay != nullptr) {
         stats.m_relay_txs = WITH_LOCK(tx_relay->m_bloom_filter_mutex, return tx_relay->m_relay_txs);
         stats.m_fee_filter_received = tx_relay->m_fee_filter_received.load();
+        LOCK(tx_relay->m_tx_inventory_mutex);
+        stats.m_stem_route = tx_relay->m_send_stem;
+        stats.m_stem_txs_sent = tx_relay->m_stem_txs_sent;
+        if (tx_relay->m_stem_txs_sent > 0) {
+            stats.m_stem_latency = tx_relay->m_stem_latency_total / tx_relay->m_stem_txs_sent;
+        }
     } else {
         stats.m_relay_txs = false;
         stats.m_fee_filter_received = 0;
@@ -1979,6 +2043,26 @@ void PeerManagerImpl::BlockConnected(
             m_txrequest.ForgetTxHash(ptx->GetWitnessHash());
         }
     }
+
+    // SendMessages only fluffs the stempool while there are peers to send
+    // to, so also let the transactions whose embargo has ended go here.
+    FluffStemTransactions(GetTime<std::chrono::microseconds>());
+}
+
+void PeerManagerImpl::TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence)
+{
+    // This includes the transactions confirmed by a BLSCT block, which are
+    // removed as conflicts of the aggregated transaction the block carries
+    EraseStemTransactions({tx->GetWitnessHash().ToUint256()});
+}
+
+void PeerManagerImpl::MempoolTransactionsRemovedForBlock(const std::vector<RemovedMempoolTransactionInfo>& txs_removed_for_block, unsigned int nBlockHeight)
+{
+    std::set<uint256> wtxids;
+    for (const auto& removed_tx : txs_removed_for_block) {
+        wtxids.insert(removed_tx.info.m_tx->GetWitnessHash().ToUint256());
+    }
+    EraseStemTransactions(wtxids);
 }
 
 void PeerManagerImpl::BlockDisconnected(const std::shared_ptr<const CBlock> &block, const CBlockIndex* pindex)
@@ -2002,6 +2086,7 @@ void PeerManagerImpl::BlockDisconnected(const std::shared_ptr<const CBlock> &blo
 void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& pblock)
 {
     auto pcmpctblock = std::make_shared<const CBlockHeaderAndShortTxIDs>(*pblock);
+    auto pcmpctblock_blsct = pblock->vBLSCTComponents.empty() ? pcmpctblock : std::make_shared<const CBlockHeaderAndShortTxIDs>(*pblock, /*blsct_components=*/true);
 
     LOCK(cs_main);
 
@@ -2014,6 +2099,8 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
     uint256 hashBlock(pblock->GetHash());
     const std::shared_future<CSerializedNetMsg> lazy_ser{
         std::async(std::launch::deferred, [&] { return NetMsg::Make(NetMsgType::CMPCTBLOCK, *pcmpctblock); })};
+    const std::shared_future<CSerializedNetMsg> lazy_ser_blsct{
+        std::async(std::launch::deferred, [&] { return NetMsg::Make(NetMsgType::CMPCTBLOCK, *pcmpctblock_blsct); })};
 
     {
         auto most_recent_block_txs = std::make_unique<std::map<uint256, CTransactionRef>>();
@@ -2026,10 +2113,11 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
         m_most_recent_block_hash = hashBlock;
         m_most_recent_block = pblock;
         m_most_recent_compact_block = pcmpctblock;
+        m_most_recent_blsct_compact_block = pcmpctblock_blsct;
         m_most_recent_block_txs = std::move(most_recent_block_txs);
     }
 
-    m_connman.ForEachNode([this, pindex, &lazy_ser, &hashBlock](CNode* pnode) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+    m_connman.ForEachNode([this, pindex, &lazy_ser, &lazy_ser_blsct, &hashBlock](CNode* pnode) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
         AssertLockHeld(::cs_main);
 
         if (pnode->GetCommonVersion() < INVALID_CB_NO_BAN_VERSION || pnode->fDisconnect)
@@ -2043,7 +2131,7 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
             LogPrint(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", "PeerManager::NewPoWValidBlock",
                     hashBlock.ToString(), pnode->GetId());
 
-            const CSerializedNetMsg& ser_cmpctblock{lazy_ser.get()};
+            const CSerializedNetMsg& ser_cmpctblock{state.m_provides_blsct_cmpctblocks ? lazy_ser_blsct.get() : lazy_ser.get()};
             PushMessage(*pnode, ser_cmpctblock.Copy());
             state.pindexBestHeaderSent = pindex;
         }
@@ -2166,6 +2254,80 @@ void PeerManagerImpl::SendPings()
 
 void PeerManagerImpl::RelayTransaction(const uint256& txid, const uint256& wtxid)
 {
+    // Transactions accepted with an embargo are in Dandelion++ stem phase.
+    // They are only announced to stem peers until FluffStemTransactions
+    // finds their embargo has ended.
+    const auto txinfo{m_mempool.info(GenTxid::Wtxid(wtxid))};
+    if (txinfo.tx && txinfo.m_embargo > GetTime<std::chrono::microseconds>()) {
+        bool stem{false};
+        {
+            LOCK(m_stempool_mutex);
+            if (m_stempool_hashes.count(wtxid)) {
+                stem = true;
+            } else if (m_stempool_vsize + txinfo.vsize <= DANDELION_MAX_STEMPOOL_VSIZE) {
+                m_stempool.push_back({txinfo.m_embargo, txid, wtxid, txinfo.vsize});
+                std::push_heap(m_stempool.begin(), m_stempool.end(), StemTxEmbargoLater{});
+                m_stempool_hashes.insert(txid);
+                m_stempool_hashes.insert(wtxid);
+                m_stempool_vsize += txinfo.vsize;
+                stem = true;
+            }
+        }
+        if (stem) {
+            QueueTransaction(txid, wtxid, /*stem_only=*/true);
+            return;
+        }
+        LogPrint(BCLog::DANDELION, "stempool full, fluffing tx=%s\n", txid.ToString());
+    }
+    QueueTransaction(txid, wtxid, /*stem_only=*/false);
+}
+
+void PeerManagerImpl::FluffStemTransactions(std::chrono::microseconds now)
+{
+    std::vector<StemTx> fluffed;
+    {
+        LOCK(m_stempool_mutex);
+        while (!m_stempool.empty() && m_stempool.front().m_embargo <= now) {
+            std::pop_heap(m_stempool.begin(), m_stempool.end(), StemTxEmbargoLater{});
+            auto& stem_tx = m_stempool.back();
+            m_stempool_hashes.erase(stem_tx.m_txid);
+            m_stempool_hashes.erase(stem_tx.m_wtxid);
+            m_stempool_vsize -= stem_tx.m_vsize;
+            fluffed.push_back(std::move(stem_tx));
+            m_stempool.pop_back();
+        }
+    }
+    for (const auto& stem_tx : fluffed) {
+        LogPrint(BCLog::DANDELION, "embargo ended, fluffing tx=%s\n", stem_tx.m_txid.ToString());
+        QueueTransaction(stem_tx.m_txid, stem_tx.m_wtxid, /*stem_only=*/false);
+    }
+}
+
+void PeerManagerImpl::EraseStemTransactions(const std::set<uint256>& wtxids)
+{
+    LOCK(m_stempool_mutex);
+    if (std::none_of(wtxids.begin(), wtxids.end(), [&](const uint256& wtxid) EXCLUSIVE_LOCKS_REQUIRED(m_stempool_mutex) { return m_stempool_hashes.count(wtxid) > 0; })) return;
+
+    const auto it{std::remove_if(m_stempool.begin(), m_stempool.end(), [&](const StemTx& stem_tx) EXCLUSIVE_LOCKS_REQUIRED(m_stempool_mutex) {
+        if (!wtxids.count(stem_tx.m_wtxid)) return false;
+        m_stempool_hashes.erase(stem_tx.m_txid);
+        m_stempool_hashes.erase(stem_tx.m_wtxid);
+        m_stempool_vsize -= stem_tx.m_vsize;
+        return true;
+    })};
+    m_stempool.erase(it, m_stempool.end());
+    std::make_heap(m_stempool.begin(), m_stempool.end(), StemTxEmbargoLater{});
+}
+
+StempoolStats PeerManagerImpl::GetStempoolStats()
+{
+    LOCK(m_stempool_mutex);
+    return {m_stempool.size(), m_stempool_vsize};
+}
+
+void PeerManagerImpl::QueueTransaction(const uint256& txid, const uint256& wtxid, bool stem_only)
+{
+    const auto now{GetTime<std::chrono::microseconds>()};
     LOCK(m_peer_mutex);
     for(auto& it : m_peer_map) {
         Peer& peer = *it.second;
@@ -2173,6 +2335,7 @@ void PeerManagerImpl::RelayTransaction(const uint256& txid, const uint256& wtxid
         if (!tx_relay) continue;
 
         LOCK(tx_relay->m_tx_inventory_mutex);
+        if (stem_only && !tx_relay->m_send_stem) continue;
         // Only queue transactions for announcement once the version handshake
         // is completed. The time of arrival for these transactions is
         // otherwise at risk of leaking to a spy, if the spy is able to
@@ -2181,7 +2344,10 @@ void PeerManagerImpl::RelayTransaction(const uint256& txid, const uint256& wtxid
         if (tx_relay->m_next_inv_send_time == 0s) continue;
 
         const uint256& hash{peer.m_wtxid_relay ? wtxid : txid};
-        if (!tx_relay->m_tx_inventory_known_filter.contains(hash)) {
+        if (tx_relay->m_tx_inventory_known_filter.contains(hash)) continue;
+        if (stem_only) {
+            tx_relay->m_stem_inventory_to_send.emplace(hash, now);
+        } else {
             tx_relay->m_tx_inventory_to_send.insert(hash);
         }
     };
@@ -2240,10 +2406,11 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
 {
     std::shared_ptr<const CBlock> a_recent_block;
     std::shared_ptr<const CBlockHeaderAndShortTxIDs> a_recent_compact_block;
+    const bool blsct_cmpctblocks{WITH_LOCK(cs_main, return State(pfrom.GetId())->m_provides_blsct_cmpctblocks)};
     {
         LOCK(m_most_recent_block_mutex);
         a_recent_block = m_most_recent_block;
-        a_recent_compact_block = m_most_recent_compact_block;
+        a_recent_compact_block = blsct_cmpctblocks ? m_most_recent_blsct_compact_block : m_most_recent_compact_block;
     }
 
     bool need_activate_chain = false;
@@ -2307,19 +2474,18 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
     } else if (inv.IsMsgWitnessBlk()) {
         // Fast-path: in this case it is possible to serve the block directly from disk,
         // as the network format matches the format on disk
-        std::vector<uint8_t> block_data;
-        if (!m_chainman.m_blockman.ReadRawBlockFromDisk(block_data, pindex->GetBlockPos())) {
+        const auto block_data{m_chainman.m_blockman.ReadRawBlockCached(*pindex)};
+        if (!block_data) {
             assert(!"cannot load block from disk");
         }
-        MakeAndPushMessage(pfrom, NetMsgType::BLOCK, Span{block_data});
+        MakeAndPushMessage(pfrom, NetMsgType::BLOCK, Span{*block_data});
         // Don't set pblock as we've sent the block
     } else {
         // Send block from disk
-        std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
-        if (!m_chainman.m_blockman.ReadBlockFromDisk(*pblockRead, *pindex)) {
+        pblock = m_chainman.m_blockman.ReadBlockCached(*pindex);
+        if (!pblock) {
             assert(!"cannot load block from disk");
         }
-        pblock = pblockRead;
     }
     if (pblock) {
         if (inv.IsMsgBlk()) {
@@ -2359,7 +2525,7 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
                 if (a_recent_compact_block && a_recent_compact_block->header.GetHash() == pindex->GetBlockHash()) {
                     MakeAndPushMessage(pfrom, NetMsgType::CMPCTBLOCK, *a_recent_compact_block);
                 } else {
-                    CBlockHeaderAndShortTxIDs cmpctblock{*pblock};
+                    CBlockHeaderAndShortTxIDs cmpctblock{*pblock, blsct_cmpctblocks};
                     MakeAndPushMessage(pfrom, NetMsgType::CMPCTBLOCK, cmpctblock);
                 }
             } else {
@@ -2430,10 +2596,9 @@ void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic
         }
 
         const auto gtxid = ToGenTxid(inv);
-        const auto current_time{GetTime<std::chrono::microseconds>()};
         auto replyMsgType = NetMsgType::TX;
         auto txinfo = m_mempool.info(gtxid);
-        bool has_embargo = txinfo.tx && txinfo.m_embargo > current_time;
+        bool has_embargo = txinfo.tx && IsStemTransaction(gtxid.GetHash());
 
         // Check if tx is embargoed
         if (has_embargo) {
@@ -3114,7 +3279,7 @@ bool PeerManagerImpl::PrepareBlockFilterRequest(CNode& node, Peer& peer,
                                                 BlockFilterIndex*& filter_index)
 {
     const bool supported_filter_type =
-        (filter_type == BlockFilterType::BASIC &&
+        ((filter_type == BlockFilterType::BASIC || filter_type == BlockFilterType::BLSCT) &&
          (peer.m_our_services & NODE_COMPACT_FILTERS));
     if (!supported_filter_type) {
         LogPrint(BCLog::NET, "peer %d requested unsupported block filter type: %d\n",
@@ -3633,6 +3798,8 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
             // cmpctblock messages.
             // We send this to non-NODE NETWORK peers as well, because
             // they may wish to request compact blocks from us
+            // Peers which don't know the BLSCT version ignore it.
+            MakeAndPushMessage(pfrom, NetMsgType::SENDCMPCT, /*high_bandwidth=*/false, /*version=*/CMPCTBLOCKS_BLSCT_VERSION);
             MakeAndPushMessage(pfrom, NetMsgType::SENDCMPCT, /*high_bandwidth=*/false, /*version=*/CMPCTBLOCKS_VERSION);
         }
 
@@ -3673,6 +3840,13 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         uint64_t sendcmpct_version{0};
         vRecv >> sendcmpct_hb >> sendcmpct_version;
 
+        if (sendcmpct_version == CMPCTBLOCKS_BLSCT_VERSION) {
+            // Only changes the encoding, the rest is negotiated by version 2
+            LOCK(cs_main);
+            State(pfrom.GetId())->m_provides_blsct_cmpctblocks = true;
+            return;
+        }
+
         // Only support compact block relay with witnesses
         if (sendcmpct_version != CMPCTBLOCKS_VERSION) return;
 
@@ -4225,6 +4399,17 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         const uint256& hash = peer->m_wtxid_relay ? wtxid : txid;
         AddKnownTx(*peer, hash);
 
+        // Range proofs do not depend on the UTXO set, so they are verified
+        // and cached without holding cs_main. Mempool acceptance then only
+        // has to check what depends on the coins being spent. Transactions
+        // which we already have or recently rejected are not verified again,
+        // they are dealt with by the AlreadyHaveTx() check below.
+        TxValidationState pre_state;
+        bool pre_verified{true};
+        if (tx.IsBLSCT() && !WITH_LOCK(cs_main, return AlreadyHaveTx(GenTxid::Wtxid(wtxid)))) {
+            pre_verified = blsct::PreVerifyTx(tx, pre_state, m_chainparams.GetConsensus().nPePoSMinStakeAmount);
+        }
+
         LOCK(cs_main);
 
         m_txrequest.ReceivedResponse(pfrom.GetId(), txid);
@@ -4274,6 +4459,18 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
             return;
         }
 
+        if (!pre_verified) {
+            m_recent_rejects.insert(wtxid);
+            m_txrequest.ForgetTxHash(wtxid);
+            LogPrint(BCLog::MEMPOOLREJ, "%s (wtxid=%s) from peer=%d was not accepted: %s\n",
+                tx.GetHash().ToString(),
+                tx.GetWitnessHash().ToString(),
+                pfrom.GetId(),
+                pre_state.ToString());
+            MaybePunishNodeForTx(pfrom.GetId(), pre_state);
+            return;
+        }
+
         const MempoolAcceptResult result = m_chainman.ProcessTransaction(ptx, /*test_accept=*/ false, is_stem);
         const TxValidationState& state = result.m_state;
 
@@ -4528,7 +4725,7 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
                 }
 
                 PartiallyDownloadedBlock& partialBlock = *(*queuedBlockIt)->partialBlock;
-                ReadStatus status = partialBlock.InitData(cmpctblock, vExtraTxnForCompact);
+                ReadStatus status = partialBlock.InitData(cmpctblock, vExtraTxnForCompact, nodestate->m_provides_blsct_cmpctblocks);
                 if (status == READ_STATUS_INVALID) {
                     RemoveBlockRequest(pindex->GetBlockHash(), pfrom.GetId()); // Reset in-flight state in case Misbehaving does not result in a disconnect
                     Misbehaving(*peer, 100, "invalid compact block");
@@ -4579,7 +4776,7 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
                 // Optimistically try to reconstruct anyway since we might be
                 // able to without any round trips.
                 PartiallyDownloadedBlock tempBlock(&m_mempool);
-                ReadStatus status = tempBlock.InitData(cmpctblock, vExtraTxnForCompact);
+                ReadStatus status = tempBlock.InitData(cmpctblock, vExtraTxnForCompact, nodestate->m_provides_blsct_cmpctblocks);
                 if (status != READ_STATUS_OK) {
                     // TODO: don't ignore failures
                     return;
@@ -4717,7 +4914,12 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         }
 
         std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
-        vRecv >> TX_WITH_WITNESS(*pblock);
+        {
+            // The subgroup checks of the points are run as a batch by CheckBlock()
+            MclG1Point::DeferredOrderChecks deferred_checks;
+            vRecv >> TX_WITH_WITNESS(*pblock);
+            pblock->vDeferredPoints = std::move(deferred_checks.points);
+        }
 
         LogPrint(BCLog::NET, "received block %s peer=%d\n", pblock->GetHash().ToString(), pfrom.GetId());
 
@@ -5543,6 +5745,9 @@ void PeerManagerImpl::ShuffleStemRoutes(const std::vector<CNode*>& nodes)
                 if (auto tx_relay = peer->GetTxRelay(); tx_relay != nullptr) {
                     LOCK(tx_relay->m_tx_inventory_mutex);
                     tx_relay->m_send_stem = false; // Reset the values
+                    // Stem transactions not yet sent along the old route are
+                    // fluffed once their embargo ends
+                    tx_relay->m_stem_inventory_to_send.clear();
                     peers.push_back(peer);
                 }
             }
@@ -5739,7 +5944,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                     {
                         LOCK(m_most_recent_block_mutex);
                         if (m_most_recent_block_hash == pBestIndex->GetBlockHash()) {
-                            cached_cmpctblock_msg = NetMsg::Make(NetMsgType::CMPCTBLOCK, *m_most_recent_compact_block);
+                            cached_cmpctblock_msg = NetMsg::Make(NetMsgType::CMPCTBLOCK, state.m_provides_blsct_cmpctblocks ? *m_most_recent_blsct_compact_block : *m_most_recent_compact_block);
                         }
                     }
                     if (cached_cmpctblock_msg.has_value()) {
@@ -5748,7 +5953,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                         CBlock block;
                         const bool ret{m_chainman.m_blockman.ReadBlockFromDisk(block, *pBestIndex)};
                         assert(ret);
-                        CBlockHeaderAndShortTxIDs cmpctblock{block};
+                        CBlockHeaderAndShortTxIDs cmpctblock{block, state.m_provides_blsct_cmpctblocks};
                         MakeAndPushMessage(*pto, NetMsgType::CMPCTBLOCK, cmpctblock);
                     }
                     state.pindexBestHeaderSent = pBestIndex;
@@ -5814,6 +6019,9 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
             peer->m_blocks_for_inv_relay.clear();
         }
 
+        // Queue the stem transactions whose embargo has ended for every peer
+        FluffStemTransactions(current_time);
+
         if (auto tx_relay = peer->GetTxRelay(); tx_relay != nullptr) {
                 LOCK(tx_relay->m_tx_inventory_mutex);
                 // Check whether periodic sends should happen
@@ -5833,6 +6041,37 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                     if (!tx_relay->m_relay_txs) tx_relay->m_tx_inventory_to_send.clear();
                 }
 
+                // Announce the queued stem transactions along this route in one
+                // batch, on a shorter timer than normal relay
+                if (tx_relay->m_send_stem && !tx_relay->m_stem_inventory_to_send.empty() &&
+                    tx_relay->m_next_stem_send_time < current_time) {
+                    tx_relay->m_next_stem_send_time = GetExponentialRand(current_time, DANDELION_STEM_INVENTORY_INTERVAL);
+                    const CFeeRate filterrate{tx_relay->m_fee_filter_received.load()};
+                    LOCK(tx_relay->m_bloom_filter_mutex);
+                    if (!tx_relay->m_relay_txs) tx_relay->m_stem_inventory_to_send.clear();
+                    for (const auto& [hash, queued_time] : tx_relay->m_stem_inventory_to_send) {
+                        // Fluffed in the meantime: normal relay announces it
+                        if (!IsStemTransaction(hash)) continue;
+                        auto txinfo = m_mempool.info(peer->m_wtxid_relay ? GenTxid::Wtxid(hash) : GenTxid::Txid(hash));
+                        if (!txinfo.tx) continue;
+                        if (txinfo.fee < filterrate.GetFee(txinfo.vsize)) continue;
+                        if (tx_relay->m_bloom_filter && !tx_relay->m_bloom_filter->IsRelevantAndUpdate(*txinfo.tx)) continue;
+                        vInv.emplace_back(peer->m_wtxid_relay ? MSG_DWTX : MSG_DTX, hash);
+                        tx_relay->m_tx_inventory_known_filter.insert(hash);
+                        tx_relay->m_stem_txs_sent++;
+                        tx_relay->m_stem_latency_total += current_time - queued_time;
+                        if (vInv.size() == MAX_INV_SZ) {
+                            MakeAndPushMessage(*pto, NetMsgType::INV, vInv);
+                            vInv.clear();
+                        }
+                    }
+                    tx_relay->m_stem_inventory_to_send.clear();
+
+                    // Ensure we'll respond to GETDATA requests for what we've just announced
+                    LOCK(m_mempool.cs);
+                    tx_relay->m_last_inv_sequence = m_mempool.GetSequence();
+                }
+
                 // Respond to BIP35 mempool requests
                 if (fSendTrickle && tx_relay->m_send_mempool) {
                     auto vtxinfo = m_mempool.infoAll();
@@ -5843,7 +6082,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
 
                     for (const auto& txinfo : vtxinfo) {
                         auto msgType = peer->m_wtxid_relay ? MSG_WTX : MSG_TX;
-                        bool has_embargo = txinfo.m_embargo > current_time;
+                        bool has_embargo = IsStemTransaction(txinfo.tx->GetWitnessHash());
                         LogPrint(BCLog::DANDELION, "mempool tx=%s has_embargo=%f peer=%d m_send_stem=%f\n", txinfo.tx->GetHash().ToString(), has_embargo, pto->GetId(), tx_relay->m_send_stem);
 
                         // Check if tx is embargoed
@@ -5917,12 +6156,18 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                             continue;
                         }
 
-                        bool has_embargo = txinfo.m_embargo > current_time;
+                        // Remove it from the to-be-sent set
+                        tx_relay->m_tx_inventory_to_send.erase(it);
+
+                        bool has_embargo = IsStemTransaction(hash);
                         LogPrint(BCLog::DANDELION, "trickle tx=%s has_embargo=%f peer=%d m_send_stem=%f\n", txinfo.tx->GetHash().ToString(), has_embargo, pto->GetId(), tx_relay->m_send_stem);
 
                         // Check if tx is embargoed
                         if (has_embargo) {
-                            // Check if peer selected as stem peer
+                            // Check if peer selected as stem peer. Stem
+                            // transactions are only queued for stem peers, and
+                            // queued again for every peer once fluffed, so a
+                            // peer that stopped being a stem peer can drop it.
                             if (!tx_relay->m_send_stem) {
                                 // Don't send embargoed Inv to non stem peers
                                 continue;
@@ -5931,9 +6176,6 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                             inv = CInv(peer->m_wtxid_relay ? MSG_DWTX : MSG_DTX, hash);
                         }
 
-                        // Remove it from the to-be-sent set
-                        tx_relay->m_tx_inventory_to_send.erase(it);
-
                         // Peer told you to not send transactions at that feerate? Don't bother sending it.
                         if (txinfo.fee < filterrate.GetFee(txinfo.vsize)) {
                             continue;
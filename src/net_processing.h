@@ -41,6 +41,14 @@ struct CNodeStateStats {
     bool m_addr_relay_enabled{false};
     ServiceFlags their_services;
     int64_t presync_height{-1};
+    bool m_stem_route{false};
+    uint64_t m_stem_txs_sent{0};
+    std::chrono::microseconds m_stem_latency{0};
+};
+
+struct StempoolStats {
+    size_t m_count{0};
+    int64_t m_vsize{0};
 };
 
 class PeerManager : public CValidationInterface, public NetEventsInterface
@@ -89,6 +97,9 @@ public:
     /** Relay transaction to all peers. */
     virtual void RelayTransaction(const uint256& txid, const uint256& wtxid) = 0;
 
+    /** Get the number and total virtual size of the transactions in Dandelion++ stem phase */
+    virtual StempoolStats GetStempoolStats() = 0;
+
     /** Send ping message to all peers */
     virtual void SendPings() = 0;
 
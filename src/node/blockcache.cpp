@@ -0,0 +1,82 @@
+// Copyright (c) 2024 The Navio developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockcache.h>
+
+#include <core_memusage.h>
+#include <memusage.h>
+
+namespace node {
+
+size_t BlockCache::EntryUsage(const Entry& entry)
+{
+    size_t usage{memusage::MallocUsage(sizeof(Node)) + memusage::MallocUsage(sizeof(std::pair<const uint256, NodeList::iterator>))};
+    if (entry.block) {
+        usage += memusage::DynamicUsage(entry.block) + RecursiveDynamicUsage(*entry.block);
+    }
+    if (entry.raw) {
+        usage += memusage::DynamicUsage(entry.raw) + memusage::DynamicUsage(*entry.raw);
+    }
+    return usage;
+}
+
+BlockCache::Entry BlockCache::Get(const uint256& hash, bool raw)
+{
+    LOCK(m_mutex);
+    const auto it{m_map.find(hash)};
+    if (it == m_map.end()) {
+        ++(raw ? m_raw_misses : m_block_misses);
+        return {};
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    const Entry& entry{it->second->entry};
+    if (raw) {
+        ++(entry.raw ? m_raw_hits : m_raw_misses);
+    } else {
+        ++(entry.block ? m_block_hits : m_block_misses);
+    }
+    return entry;
+}
+
+void BlockCache::Insert(const uint256& hash, const Entry& entry)
+{
+    LOCK(m_mutex);
+    auto it{m_map.find(hash)};
+    if (it == m_map.end()) {
+        m_lru.push_front(Node{hash, {}, 0});
+        it = m_map.emplace(hash, m_lru.begin()).first;
+    } else {
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+    }
+    Node& node{*it->second};
+    if (!node.entry.block) node.entry.block = entry.block;
+    if (!node.entry.raw) node.entry.raw = entry.raw;
+    m_usage -= node.usage;
+    node.usage = EntryUsage(node.entry);
+    m_usage += node.usage;
+
+    // A block larger than the whole cache evicts everything including itself.
+    while (m_usage > m_max_usage && !m_lru.empty()) {
+        const Node& lru{m_lru.back()};
+        m_usage -= lru.usage;
+        m_map.erase(lru.hash);
+        m_lru.pop_back();
+    }
+}
+
+BlockCache::Stats BlockCache::GetStats() const
+{
+    LOCK(m_mutex);
+    Stats stats;
+    stats.entries = m_map.size();
+    stats.usage = m_usage;
+    stats.max_usage = m_max_usage;
+    stats.block_hits = m_block_hits;
+    stats.block_misses = m_block_misses;
+    stats.raw_hits = m_raw_hits;
+    stats.raw_misses = m_raw_misses;
+    return stats;
+}
+
+} // namespace node
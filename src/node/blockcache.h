@@ -0,0 +1,92 @@
+// Copyright (c) 2024 The Navio developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKCACHE_H
+#define BITCOIN_NODE_BLOCKCACHE_H
+
+#include <primitives/block.h>
+#include <sync.h>
+#include <uint256.h>
+#include <util/hasher.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+
+/**
+ * Size-bounded LRU cache of blocks read from disk, keyed by block hash.
+ *
+ * Each block can be held deserialized, in its serialized form as stored in
+ * the block files, or both, so that a block which was read once for one
+ * purpose (e.g. a getblock RPC) does not have to be read and deserialized
+ * again for another (e.g. a peer requesting it). Deserializing a block
+ * decompresses every curve point of its BLSCT outputs, which makes this
+ * much more expensive than the disk read itself.
+ *
+ * Blocks are immutable once stored, so entries never need to be invalidated.
+ */
+class BlockCache
+{
+public:
+    struct Entry {
+        std::shared_ptr<const CBlock> block;
+        std::shared_ptr<const std::vector<uint8_t>> raw;
+    };
+
+    struct Stats {
+        size_t entries{0};
+        size_t usage{0};
+        size_t max_usage{0};
+        uint64_t block_hits{0};
+        uint64_t block_misses{0};
+        uint64_t raw_hits{0};
+        uint64_t raw_misses{0};
+    };
+
+    explicit BlockCache(size_t max_usage) : m_max_usage{max_usage} {}
+
+    /**
+     * Look up a block and mark it as most recently used. A hit is counted if
+     * the requested form (raw or deserialized) is cached, a miss otherwise.
+     * Every form that is cached is returned, so that on a miss the caller can
+     * still derive the requested form from the other one.
+     */
+    Entry Get(const uint256& hash, bool raw) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** Add the given forms of a block, keeping forms already cached, and evict the least recently used blocks while over the size limit. */
+    void Insert(const uint256& hash, const Entry& entry) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    Stats GetStats() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    struct Node {
+        uint256 hash;
+        Entry entry;
+        size_t usage{0};
+    };
+    using NodeList = std::list<Node>;
+
+    static size_t EntryUsage(const Entry& entry);
+
+    const size_t m_max_usage;
+
+    mutable Mutex m_mutex;
+    //! Most recently used first.
+    NodeList m_lru GUARDED_BY(m_mutex);
+    std::unordered_map<uint256, NodeList::iterator, BlockHasher> m_map GUARDED_BY(m_mutex);
+    size_t m_usage GUARDED_BY(m_mutex){0};
+    uint64_t m_block_hits GUARDED_BY(m_mutex){0};
+    uint64_t m_block_misses GUARDED_BY(m_mutex){0};
+    uint64_t m_raw_hits GUARDED_BY(m_mutex){0};
+    uint64_t m_raw_misses GUARDED_BY(m_mutex){0};
+};
+
+} // namespace node
+
+#endif // BITCOIN_NODE_BLOCKCACHE_H
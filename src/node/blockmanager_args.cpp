@@ -33,6 +33,13 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, BlockManager::Op
 
     if (auto value{args.GetBoolArg("-fastprune")}) opts.fast_prune = *value;
 
+    if (auto mb{args.GetIntArg("-blockcachesize")}) {
+        if (*mb < 0) {
+            return util::Error{_("Block cache size cannot be configured with a negative value.")};
+        }
+        opts.block_cache_size = uint64_t(*mb) * 1024 * 1024;
+    }
+
     return {};
 }
 } // namespace node
@@ -436,6 +436,7 @@ bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockha
         previous_index = pindex;
         pindex->nChainWork = (pindex->pprev ? pindex->pprev->nChainWork : 0) + GetBlockProof(*pindex);
         pindex->nTimeMax = (pindex->pprev ? std::max(pindex->pprev->nTimeMax, pindex->nTime) : pindex->nTime);
+        pindex->UpdateStakeModifierIndex();
 
         // We can link the chain of blocks for which we've received transactions at some point, or
         // blocks that are assumed-valid on the basis of snapshot load (see
@@ -1023,6 +1024,22 @@ bool BlockManager::WriteUndoDataForBlock(const CBlockUndo& blockundo, BlockValid
     return true;
 }
 
+//! Check the header of a block read back from the block files.
+static bool CheckBlockRead(const CBlock& block, const Consensus::Params& consensus, const std::string& where)
+{
+    // Check the header
+    if (!block.IsProofOfStake() && !CheckProofOfWork(block.GetHash(), block.nBits, consensus)) {
+        return error("ReadBlockFromDisk: Errors in block header at %s", where);
+    }
+
+    // Signet only: check block solution
+    if (consensus.signet_blocks && !CheckSignetBlockSolution(block, consensus)) {
+        return error("ReadBlockFromDisk: Errors in block solution at %s", where);
+    }
+
+    return true;
+}
+
 bool BlockManager::ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos) const
 {
     block.SetNull();
@@ -1040,18 +1057,7 @@ bool BlockManager::ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos) cons
         return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
     }
 
-
-    // Check the header
-    if (!block.IsProofOfStake() && !CheckProofOfWork(block.GetHash(), block.nBits, GetConsensus())) {
-        return error("ReadBlockFromDisk: Errors in block header at %s", pos.ToString());
-    }
-
-    // Signet only: check block solution
-    if (GetConsensus().signet_blocks && !CheckSignetBlockSolution(block, GetConsensus())) {
-        return error("ReadBlockFromDisk: Errors in block solution at %s", pos.ToString());
-    }
-
-    return true;
+    return CheckBlockRead(block, GetConsensus(), pos.ToString());
 }
 
 bool BlockManager::ReadBlockFromDisk(CBlock& block, const CBlockIndex& index) const
@@ -1103,6 +1109,58 @@ bool BlockManager::ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatF
     return true;
 }
 
+std::shared_ptr<const CBlock> BlockManager::ReadBlockCached(const CBlockIndex& index, bool populate)
+{
+    const uint256 hash{index.GetBlockHash()};
+    const BlockCache::Entry cached{m_block_cache.Get(hash, /*raw=*/false)};
+    if (cached.block) return cached.block;
+
+    // Blocks are only stored after CheckBlock() ran the subgroup checks of
+    // their points, and blocks served from here are not validated again.
+    MclG1Point::DeferredOrderChecks skip_order_checks{/*collect=*/false};
+    auto block{std::make_shared<CBlock>()};
+    if (cached.raw) {
+        // Deserialize the cached block file contents instead of reading them again
+        try {
+            SpanReader{*cached.raw} >> TX_WITH_WITNESS(*block);
+        } catch (const std::exception& e) {
+            LogPrintf("ERROR: %s: Deserialize error - %s for %s\n", __func__, e.what(), index.ToString());
+            return nullptr;
+        }
+        if (!CheckBlockRead(*block, GetConsensus(), index.ToString())) {
+            return nullptr;
+        }
+        if (block->GetHash() != hash) {
+            LogPrintf("ERROR: %s: GetHash() doesn't match index for %s\n", __func__, index.ToString());
+            return nullptr;
+        }
+    } else if (!ReadBlockFromDisk(*block, index)) {
+        return nullptr;
+    }
+    // Never keep points collected by a deferred scope of the caller alive in the cache
+    block->vDeferredPoints.clear();
+    block->vDeferredPoints.shrink_to_fit();
+    if (populate) m_block_cache.Insert(hash, {.block = block, .raw = nullptr});
+    return block;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> BlockManager::ReadRawBlockCached(const CBlockIndex& index, bool populate)
+{
+    const uint256 hash{index.GetBlockHash()};
+    const BlockCache::Entry cached{m_block_cache.Get(hash, /*raw=*/true)};
+    if (cached.raw) return cached.raw;
+
+    auto raw{std::make_shared<std::vector<uint8_t>>()};
+    if (cached.block) {
+        // Blocks are stored in the block files as serialized here
+        VectorWriter{*raw, 0, TX_WITH_WITNESS(*cached.block)};
+    } else if (!ReadRawBlockFromDisk(*raw, WITH_LOCK(::cs_main, return index.GetBlockPos()))) {
+        return nullptr;
+    }
+    if (populate) m_block_cache.Insert(hash, {.block = nullptr, .raw = raw});
+    return raw;
+}
+
 FlatFilePos BlockManager::SaveBlockToDisk(const CBlock& block, int nHeight, const FlatFilePos* dbp)
 {
     unsigned int nBlockSize = ::GetSerializeSize(TX_WITH_WITNESS(block));
@@ -13,6 +13,7 @@
 #include <kernel/chainparams.h>
 #include <kernel/cs_main.h>
 #include <kernel/messagestartchars.h>
+#include <node/blockcache.h>
 #include <primitives/block.h>
 #include <streams.h>
 #include <sync.h>
@@ -248,12 +249,15 @@ private:
 
     const kernel::BlockManagerOpts m_opts;
 
+    BlockCache m_block_cache;
+
 public:
     using Options = kernel::BlockManagerOpts;
 
     explicit BlockManager(const util::SignalInterrupt& interrupt, Options opts)
         : m_prune_mode{opts.prune_target > 0},
           m_opts{std::move(opts)},
+          m_block_cache{m_opts.block_cache_size},
           m_interrupt{interrupt} {};
 
     const util::SignalInterrupt& m_interrupt;
@@ -365,6 +369,21 @@ public:
     bool ReadBlockFromDisk(CBlock& block, const CBlockIndex& index) const;
     bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos) const;
 
+    /**
+     * Read a block through the cache of recently read blocks, for serving it
+     * to peers and clients. The returned block is shared with other readers.
+     * Returns nullptr if the block cannot be read.
+     *
+     * @param populate  Whether to add the block to the cache if it is not
+     *                  cached yet. Scans over many blocks pass false so they
+     *                  don't evict the blocks that are requested repeatedly.
+     */
+    std::shared_ptr<const CBlock> ReadBlockCached(const CBlockIndex& index, bool populate = true);
+    /** Like ReadBlockCached(), returning the block as serialized in the block files. */
+    std::shared_ptr<const std::vector<uint8_t>> ReadRawBlockCached(const CBlockIndex& index, bool populate = true);
+
+    BlockCache::Stats GetBlockCacheStats() const { return m_block_cache.GetStats(); }
+
     bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex& index) const;
 
     void CleanupBlockRevFiles() const;
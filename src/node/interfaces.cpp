@@ -28,6 +28,7 @@
 #include <node/coin.h>
 #include <node/context.h>
 #include <node/interface_ui.h>
+#include <node/miner.h>
 #include <node/mini_miner.h>
 #include <node/transaction.h>
 #include <policy/feerate.h>
@@ -668,6 +669,10 @@ public:
         // that Chain clients do not need to know about.
         return TransactionError::OK == err;
     }
+    std::optional<uint256> stakeBlock(const std::vector<std::pair<MclScalar, MclScalar>>& commitments, const blsct::SubAddress& destination) override
+    {
+        return StakeBLSCTBlock(chainman(), m_node.mempool.get(), commitments, destination);
+    }
     void getTransactionAncestry(const uint256& txid, size_t& ancestors, size_t& descendants, size_t* ancestorsize, CAmount* ancestorfees) override
     {
         ancestors = descendants = 0;
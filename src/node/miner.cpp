@@ -6,6 +6,7 @@
 #include <node/miner.h>
 
 #include <blsct/pos/pos.h>
+#include <blsct/pos/proof_logic.h>
 #include <blsct/wallet/txfactory.h>
 #include <chain.h>
 #include <chainparams.h>
@@ -265,10 +266,7 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBLSCTBlock(const blsct:
     coinbaseTx.vin[0].scriptSig = CScript() << nHeight << OP_0;
     pblock->vtx[0] = MakeTransactionRef(std::move(coinbaseTx));
     if (pblock->vtx.size() > 1) {
-        std::vector<CTransactionRef> vToAggregate(pblock->vtx.begin() + 1, pblock->vtx.begin() + pblock->vtx.size());
-        auto aggregatedTx = blsct::AggregateTransactions(vToAggregate);
-        pblock->vtx.resize(1);
-        pblock->vtx.push_back(aggregatedTx);
+        AggregateBLSCTTransactions(*pblock);
     }
     Assert(pblock->vtx.size() <= 2);
 
@@ -300,6 +298,74 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBLSCTBlock(const blsct:
     return std::move(pblocktemplate);
 }
 
+void BlockAssembler::AggregateBLSCTTransactions(CBlock& block)
+{
+    LOCK(m_blsct_template_mutex);
+    auto& cache = m_blsct_template_cache;
+    const std::vector<CTransactionRef> txs(block.vtx.begin() + 1, block.vtx.end());
+
+    bool fRebuild = !cache.aggregator;
+    if (!fRebuild) {
+        std::unordered_set<Txid, SaltedTxidHasher> selected;
+        for (const auto& tx : txs) {
+            selected.insert(tx->GetHash());
+        }
+
+        // Remove the transactions which are not selected anymore, e.g. because
+        // they were mined, children before their parents. A kept transaction
+        // whose parent was dropped needs its input restored, which only a
+        // rebuild does.
+        const std::vector<CTransactionRef> aggregated{cache.aggregator->GetTransactions()};
+        for (auto it = aggregated.rbegin(); it != aggregated.rend() && !fRebuild; ++it) {
+            const Txid& txid = (*it)->GetHash();
+            if (selected.count(txid)) continue;
+            fRebuild = !cache.aggregator->Remove(txid);
+            cache.txids.erase(txid);
+        }
+
+        // Transactions are selected with their ancestors, so new ones can be
+        // appended unless one of them is the parent of a kept transaction,
+        // which happens when a reorg returns it to the mempool.
+        if (!fRebuild) {
+            std::unordered_set<Txid, SaltedTxidHasher> parents;
+            for (const auto& tx : cache.aggregator->GetTransactions()) {
+                for (const auto& in : tx->vin) {
+                    parents.insert(in.prevout.hash);
+                }
+            }
+            fRebuild = std::any_of(txs.begin(), txs.end(), [&](const CTransactionRef& tx) {
+                return !cache.txids.count(tx->GetHash()) && parents.count(tx->GetHash());
+            });
+        }
+    }
+
+    if (fRebuild) {
+        cache.txids.clear();
+        cache.aggregator.emplace(/*fCutThrough=*/true);
+    }
+
+    for (const auto& tx : txs) {
+        if (cache.txids.insert(tx->GetHash()).second) {
+            cache.aggregator->Add(tx);
+        }
+    }
+
+    auto aggregatedTx = cache.aggregator->GetTransaction();
+    cache.hashAggregated = aggregatedTx->GetHash();
+
+    block.vtx.resize(1);
+    block.vtx.push_back(aggregatedTx);
+    block.vBLSCTComponents = cache.aggregator->GetTransactions();
+}
+
+std::vector<CTransactionRef> BlockAssembler::GetBLSCTComponents(const CTransaction& aggregated_tx)
+{
+    LOCK(m_blsct_template_mutex);
+    const auto& cache = m_blsct_template_cache;
+    if (!cache.aggregator || cache.hashAggregated != aggregated_tx.GetHash()) return {};
+    return cache.aggregator->GetTransactions();
+}
+
 void BlockAssembler::onlyUnconfirmed(CTxMemPool::setEntries& testSet)
 {
     for (CTxMemPool::setEntries::iterator iit = testSet.begin(); iit != testSet.end(); ) {
@@ -338,7 +404,14 @@ bool BlockAssembler::TestPackageTransactions(const CTxMemPool::setEntries& packa
 
 void BlockAssembler::AddToBlock(CTxMemPool::txiter iter)
 {
-    if (iter->GetTx().IsBLSCT() && iter->GetMemPoolParents().size() > 0) return;
+    // Chained BLSCT transactions can only be included together with their
+    // parents, as the outputs spent between them are cut through when
+    // aggregating the block transaction
+    if (iter->GetTx().IsBLSCT()) {
+        for (const CTxMemPoolEntry& parent : iter->GetMemPoolParentsConst()) {
+            if (!inBlock.count(parent.GetSharedTx()->GetHash())) return;
+        }
+    }
     pblocktemplate->block.vtx.emplace_back(iter->GetSharedTx());
     pblocktemplate->vTxFees.push_back(iter->GetFee());
     pblocktemplate->vTxSigOpsCost.push_back(iter->GetSigOpCost());
@@ -552,4 +625,63 @@ void BlockAssembler::addPackageTxs(const CTxMemPool& mempool, int& nPackagesSele
         nDescendantsUpdated += UpdatePackagesForAdded(mempool, ancestors, mapModifiedTx);
     }
 }
+std::optional<uint256> StakeBLSCTBlock(ChainstateManager& chainman, const CTxMemPool* mempool, const std::vector<std::pair<MclScalar, MclScalar>>& commitments, const blsct::SubAddress& destination)
+{
+    const Consensus::Params& params{chainman.GetConsensus()};
+    auto block = std::make_shared<CBlock>();
+    const CBlockIndex* pindexPrev;
+    Points staked_commitments;
+    std::vector<std::pair<MclScalar, MclScalar>> eligible;
+
+    {
+        LOCK(::cs_main);
+        if (chainman.IsInitialBlockDownload()) return std::nullopt;
+
+        pindexPrev = chainman.ActiveChain().Tip();
+        if (!pindexPrev) return std::nullopt;
+
+        // Check the kernels at the time the block would get before paying for its assembly
+        block->nTime = std::max<int64_t>(pindexPrev->GetMedianTimePast() + 1, TicksSinceEpoch<std::chrono::seconds>(GetAdjustedTime()));
+        if (std::none_of(commitments.begin(), commitments.end(), [&](const auto& commitment) {
+                return blsct::ProofOfStakeLogic::IsKernelEligible(commitment.first, commitment.second, pindexPrev, *block, params);
+            })) {
+            return std::nullopt;
+        }
+
+        auto blockReward = (pindexPrev->nHeight + 1) == 1 ? params.nBLSCTFirstBlockReward : params.nBLSCTBlockReward;
+        auto pblocktemplate = BlockAssembler{chainman.ActiveChainstate(), mempool}.CreateNewBLSCTBlock(destination, blockReward, {}, /*fPos=*/true);
+        if (!pblocktemplate) return std::nullopt;
+        *block = pblocktemplate->block;
+
+        for (const auto& commitment : commitments) {
+            if (blsct::ProofOfStakeLogic::IsKernelEligible(commitment.first, commitment.second, pindexPrev, *block, params)) {
+                eligible.push_back(commitment);
+            }
+        }
+        if (eligible.empty()) return std::nullopt;
+
+        staked_commitments = chainman.ActiveChainstate().CoinsTip().GetStakedCommitments().GetElements();
+    }
+
+    // Building the set membership proof is the expensive part, so it is done
+    // without cs_main against the staked set taken together with the tip.
+    bool found{false};
+    for (const auto& [m, f] : eligible) {
+        block->posProof = blsct::ProofOfStakeLogic::Create(staked_commitments, m, f, pindexPrev, *block, params);
+        found = blsct::ProofOfStakeLogic::Verify(staked_commitments, pindexPrev, *block, params);
+        if (found) break;
+    }
+    if (!found) return std::nullopt;
+
+    block->hashMerkleRoot = BlockMerkleRoot(*block);
+
+    // The proof only holds for the staked set of the tip it was built on
+    if (WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip()) != pindexPrev) return std::nullopt;
+
+    if (!chainman.ProcessNewBlock(block, /*force_processing=*/true, /*min_pow_checked=*/true, /*new_block=*/nullptr)) {
+        return std::nullopt;
+    }
+
+    return block->GetHash();
+}
 } // namespace node
@@ -14,6 +14,8 @@
 #include <memory>
 #include <optional>
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/indexed_by.hpp>
@@ -172,14 +174,35 @@ public:
     inline static std::optional<int64_t> m_last_block_num_txs{};
     inline static std::optional<int64_t> m_last_block_weight{};
 
+    /** Running aggregate of the transactions of the last BLSCT block template,
+      * shared by all assemblers (getblocktemplate, staking) as they select
+      * from the same mempool */
+    struct BLSCTTemplateCache {
+        std::unordered_set<Txid, SaltedTxidHasher> txids;
+        std::optional<blsct::TxAggregator> aggregator;
+        uint256 hashAggregated;
+    };
+
+    /** Return the transactions aggregated into aggregated_tx if it is the
+      * aggregated transaction of the last BLSCT block template, or an empty
+      * vector otherwise */
+    static std::vector<CTransactionRef> GetBLSCTComponents(const CTransaction& aggregated_tx) EXCLUSIVE_LOCKS_REQUIRED(!m_blsct_template_mutex);
+
 private:
     const Options m_options;
 
+    inline static Mutex m_blsct_template_mutex;
+    inline static BLSCTTemplateCache m_blsct_template_cache GUARDED_BY(m_blsct_template_mutex);
+
     // utility functions
     /** Clear the block's state and prepare for assembling a new block */
     void resetBlock();
     /** Add a tx to the block */
     void AddToBlock(CTxMemPool::txiter iter);
+    /** Replace the BLSCT transactions of the block by their aggregate, updating
+      * the aggregate of the previous template by removing the transactions
+      * which were dropped since and adding the new ones */
+    void AggregateBLSCTTransactions(CBlock& block) EXCLUSIVE_LOCKS_REQUIRED(!m_blsct_template_mutex);
 
     // Methods for how to add transactions to a block.
     /** Add transactions based on feerate including unconfirmed ancestors
@@ -208,6 +231,15 @@ void RegenerateCommitments(CBlock& block, ChainstateManager& chainman);
 
 /** Apply -blockmintxfee and -blockmaxweight options from ArgsManager to BlockAssembler options. */
 void ApplyArgsManOptions(const ArgsManager& gArgs, BlockAssembler::Options& options);
+
+/**
+ * Try to stake a block on top of the active chain tip with one of the given
+ * staked commitments, each given as its (value, gamma) pair, and submit it
+ * through ProcessNewBlock. Only assembles a block if one of the kernels meets
+ * the target. The proof is built without holding cs_main, and the block is
+ * dropped if the tip changed meanwhile. Returns the hash of the accepted block.
+ */
+std::optional<uint256> StakeBLSCTBlock(ChainstateManager& chainman, const CTxMemPool* mempool, const std::vector<std::pair<MclScalar, MclScalar>>& commitments, const blsct::SubAddress& destination);
 } // namespace node
 
 #endif // BITCOIN_NODE_MINER_H
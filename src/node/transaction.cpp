@@ -3,6 +3,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <blsct/wallet/verification.h>
 #include <consensus/validation.h>
 #include <index/txindex.h>
 #include <net.h>
@@ -44,6 +45,13 @@ TransactionError BroadcastTransaction(NodeContext& node, const CTransactionRef t
     uint256 wtxid = tx->GetWitnessHash();
     bool callback_set = false;
 
+    if (tx->IsBLSCT()) {
+        TxValidationState state;
+        if (!blsct::PreVerifyTx(*tx, state, node.chainman->GetConsensus().nPePoSMinStakeAmount)) {
+            return HandleATMPError(state, err_string);
+        }
+    }
+
     {
         LOCK(cs_main);
 
@@ -4,6 +4,7 @@
 
 #include <node/utxo_snapshot.h>
 
+#include <hash.h>
 #include <logging.h>
 #include <streams.h>
 #include <sync.h>
@@ -13,6 +14,7 @@
 #include <util/fs.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <optional>
@@ -20,6 +22,39 @@
 
 namespace node {
 
+SnapshotChunk::SnapshotChunk(const std::vector<std::pair<COutPoint, Coin>>& coins)
+    : m_coins_count{static_cast<uint32_t>(coins.size())}
+{
+    VectorWriter writer{m_coins, 0};
+    for (const auto& [outpoint, coin] : coins) {
+        writer << outpoint << coin;
+    }
+    m_checksum = ComputeChecksum();
+}
+
+uint256 SnapshotChunk::ComputeChecksum() const
+{
+    return (HashWriter{} << m_coins_count << m_coins).GetHash();
+}
+
+bool SnapshotChunk::GetCoins(std::vector<std::pair<COutPoint, Coin>>& coins) const
+{
+    if (ComputeChecksum() != m_checksum) return false;
+
+    coins.clear();
+    coins.reserve(std::min(m_coins_count, SNAPSHOT_CHUNK_COINS));
+    SpanReader reader{m_coins};
+    try {
+        for (uint32_t i = 0; i < m_coins_count; ++i) {
+            auto& [outpoint, coin] = coins.emplace_back();
+            reader >> outpoint >> coin;
+        }
+    } catch (const std::ios_base::failure&) {
+        return false;
+    }
+    return reader.empty();
+}
+
 bool WriteSnapshotBaseBlockhash(Chainstate& snapshot_chainstate)
 {
     AssertLockHeld(::cs_main);
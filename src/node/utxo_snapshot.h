@@ -6,24 +6,46 @@
 #ifndef BITCOIN_NODE_UTXO_SNAPSHOT_H
 #define BITCOIN_NODE_UTXO_SNAPSHOT_H
 
+#include <blsct/arith/elements.h>
+#include <blsct/arith/mcl/mcl_g1point.h>
+#include <coins.h>
 #include <kernel/cs_main.h>
+#include <primitives/transaction.h>
 #include <serialize.h>
 #include <sync.h>
+#include <tinyformat.h>
 #include <uint256.h>
 #include <util/fs.h>
 
+#include <array>
 #include <cstdint>
+#include <ios>
 #include <optional>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 class Chainstate;
 
 namespace node {
+
+//! Leading bytes of a UTXO snapshot, which tell it apart from other files
+static constexpr std::array<uint8_t, 5> SNAPSHOT_MAGIC_BYTES{'u', 't', 'x', 'o', 0xff};
+
+//! Number of coins serialized together in a chunk of a UTXO snapshot
+static constexpr uint32_t SNAPSHOT_CHUNK_COINS{4096};
+
+//! Upper bound on the threads encoding or decoding chunks of a UTXO snapshot
+static constexpr int MAX_SNAPSHOT_THREADS{8};
+
 //! Metadata describing a serialized version of a UTXO set from which an
 //! assumeutxo Chainstate can be constructed.
 class SnapshotMetadata
 {
 public:
+    //! Version of the snapshot format, bumped whenever the layout changes.
+    static constexpr uint16_t VERSION{1};
+
     //! The hash of the block that reflects the tip of the chain for the
     //! UTXO set contained in this snapshot.
     uint256 m_base_blockhash;
@@ -32,14 +54,70 @@ public:
     //! during snapshot load to estimate progress of UTXO set reconstruction.
     uint64_t m_coins_count = 0;
 
+    //! The value commitments of the staked coins in this snapshot. They are
+    //! checked against the coins while loading rather than rebuilt from them.
+    OrderedElements<MclG1Point> m_staked_commitments;
+
     SnapshotMetadata() { }
     SnapshotMetadata(
         const uint256& base_blockhash,
-        uint64_t coins_count) :
+        uint64_t coins_count,
+        OrderedElements<MclG1Point> staked_commitments = {}) :
             m_base_blockhash(base_blockhash),
-            m_coins_count(coins_count) { }
+            m_coins_count(coins_count),
+            m_staked_commitments(std::move(staked_commitments)) { }
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s << SNAPSHOT_MAGIC_BYTES << VERSION << m_base_blockhash << m_coins_count << m_staked_commitments;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        std::array<uint8_t, SNAPSHOT_MAGIC_BYTES.size()> magic;
+        s >> magic;
+        if (magic != SNAPSHOT_MAGIC_BYTES) {
+            throw std::ios_base::failure("Invalid UTXO set snapshot magic bytes. Please check if this is indeed a snapshot file or if you are using an outdated snapshot format.");
+        }
+        uint16_t version;
+        s >> version;
+        if (version != VERSION) {
+            throw std::ios_base::failure(strprintf("Version of snapshot %s does not match the supported version %s.", version, VERSION));
+        }
+        s >> m_base_blockhash >> m_coins_count >> m_staked_commitments;
+    }
+};
+
+/**
+ * A run of consecutive coins of a UTXO snapshot. The coins of a snapshot
+ * follow its metadata as a sequence of chunks, each of which carries its own
+ * checksum so that chunks can be encoded and decoded on separate threads.
+ */
+class SnapshotChunk
+{
+public:
+    //! The number of coins serialized in m_coins.
+    uint32_t m_coins_count{0};
+
+    //! The serialized outpoints and coins.
+    std::vector<unsigned char> m_coins;
+
+    //! The hash of the count and the serialized coins.
+    uint256 m_checksum;
+
+    SnapshotChunk() = default;
+    explicit SnapshotChunk(const std::vector<std::pair<COutPoint, Coin>>& coins);
+
+    //! Check the checksum and decode the coins. Returns false if the chunk is
+    //! corrupted or does not hold exactly m_coins_count coins.
+    [[nodiscard]] bool GetCoins(std::vector<std::pair<COutPoint, Coin>>& coins) const;
+
+    SERIALIZE_METHODS(SnapshotChunk, obj) { READWRITE(obj.m_coins_count, obj.m_coins, obj.m_checksum); }
 
-    SERIALIZE_METHODS(SnapshotMetadata, obj) { READWRITE(obj.m_base_blockhash, obj.m_coins_count); }
+private:
+    uint256 ComputeChecksum() const;
 };
 
 //! The file in the snapshot chainstate dir which stores the base blockhash. This is
@@ -102,6 +102,12 @@ public:
 
     // memory only
     mutable bool fChecked;
+    // points read with their subgroup check deferred, dropped by CheckBlock()
+    // once checked
+    mutable std::vector<MclG1Point> vDeferredPoints;
+    // transactions aggregated into the BLSCT block transaction, when known,
+    // in aggregation order. Used to relay compact blocks.
+    std::vector<CTransactionRef> vBLSCTComponents;
 
     CBlock()
     {
@@ -124,6 +130,8 @@ public:
         CBlockHeader::SetNull();
         vtx.clear();
         fChecked = false;
+        vDeferredPoints.clear();
+        vBLSCTComponents.clear();
     }
 
     uint256 GetHashWithoutPoSProof() const;
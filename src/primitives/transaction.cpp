@@ -78,7 +78,7 @@ uint256 CTxOut::GetHash() const
 }
 
 CMutableTransaction::CMutableTransaction() : nVersion(CTransaction::CURRENT_VERSION), nLockTime(0) {}
-CMutableTransaction::CMutableTransaction(const CTransaction& tx) : vin(tx.vin), vout(tx.vout), nVersion(tx.nVersion), nLockTime(tx.nLockTime), txSig(tx.txSig) {}
+CMutableTransaction::CMutableTransaction(const CTransaction& tx) : vin(tx.vin), vout(tx.vout), nVersion(tx.nVersion), nLockTime(tx.nLockTime), txSig(tx.txSig), vCutThrough(tx.vCutThrough) {}
 
 Txid CMutableTransaction::GetHash() const
 {
@@ -106,8 +106,30 @@ Wtxid CTransaction::ComputeWitnessHash() const
     return Wtxid::FromUint256((HashWriter{} << TX_WITH_WITNESS(*this)).GetHash());
 }
 
-CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), nVersion(tx.nVersion), nLockTime(tx.nLockTime), txSig(tx.txSig), m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
-CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), nVersion(tx.nVersion), nLockTime(tx.nLockTime), txSig(tx.txSig), m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
+std::vector<uint256> CTransaction::ComputeInHashes() const
+{
+    std::vector<uint256> ret;
+    if (!IsBLSCT()) return ret;
+    ret.reserve(vin.size());
+    for (const auto& in : vin) {
+        ret.push_back(in.GetHash());
+    }
+    return ret;
+}
+
+std::vector<uint256> CTransaction::ComputeOutHashes() const
+{
+    std::vector<uint256> ret;
+    if (!IsBLSCT()) return ret;
+    ret.reserve(vout.size());
+    for (const auto& out : vout) {
+        ret.push_back(out.GetHash());
+    }
+    return ret;
+}
+
+CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), nVersion(tx.nVersion), nLockTime(tx.nLockTime), txSig(tx.txSig), vCutThrough(tx.vCutThrough), m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()}, m_in_hashes{ComputeInHashes()}, m_out_hashes{ComputeOutHashes()} {}
+CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), nVersion(tx.nVersion), nLockTime(tx.nLockTime), txSig(tx.txSig), vCutThrough(std::move(tx.vCutThrough)), m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()}, m_in_hashes{ComputeInHashes()}, m_out_hashes{ComputeOutHashes()} {}
 
 CAmount CTransaction::GetValueOut() const
 {
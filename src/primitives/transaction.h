@@ -213,6 +213,33 @@ public:
     }
 };
 
+/** A public key and message hash pair of the signature of an aggregated BLSCT
+ * transaction which belongs to an output, or to the input spending it, that was
+ * removed from the transaction because the output was created and spent inside
+ * of it (cut-through). The pair is still needed to verify the signature.
+ */
+class CTxCutThroughTerm
+{
+public:
+    MclG1Point publicKey;
+    uint256 messageHash;
+
+    CTxCutThroughTerm() {}
+    CTxCutThroughTerm(const MclG1Point& publicKeyIn, const uint256& messageHashIn) : publicKey(publicKeyIn), messageHash(messageHashIn) {}
+
+    SERIALIZE_METHODS(CTxCutThroughTerm, obj) { READWRITE(obj.publicKey, obj.messageHash); }
+
+    friend bool operator==(const CTxCutThroughTerm& a, const CTxCutThroughTerm& b)
+    {
+        return a.publicKey == b.publicKey && a.messageHash == b.messageHash;
+    }
+
+    friend bool operator!=(const CTxCutThroughTerm& a, const CTxCutThroughTerm& b)
+    {
+        return !(a == b);
+    }
+};
+
 /** An output of a transaction.  It contains the public key that the next input
  * must be able to sign with to claim it.
  */
@@ -361,6 +388,13 @@ static constexpr TransactionSerParams TX_NO_WITNESS{.allow_witness = false};
  * - if (flags & 1):
  *   - CScriptWitness scriptWitness; (deserialized into CTxIn)
  * - uint32_t nLockTime
+ * - if BLSCT:
+ *   - blsct::Signature txSig
+ *   - if (flags & 2):
+ *     - std::vector<CTxCutThroughTerm> vCutThrough
+ *
+ * The cut-through flag is set independently of witness support, so that
+ * the terms are committed to by the txid.
  */
 template<typename Stream, typename TxType>
 void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& params)
@@ -374,7 +408,7 @@ void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& p
     /* Try to read the vin. In case the dummy is there, this will be read as an empty vector. */
     s >> tx.vin;
 
-    if (tx.vin.size() == 0 && fAllowWitness) {
+    if (tx.vin.size() == 0 && (fAllowWitness || tx.IsBLSCT())) {
         /* We read a dummy or an empty vin. */
         s >> flags;
         if (flags != 0) {
@@ -397,6 +431,14 @@ void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& p
             throw std::ios_base::failure("Superfluous witness record");
         }
     }
+    const bool fCutThrough = flags & 2;
+    if (fCutThrough) {
+        /* Only BLSCT transactions can have cut-through terms. */
+        if (!tx.IsBLSCT()) {
+            throw std::ios_base::failure("Unexpected cut-through record");
+        }
+        flags ^= 2;
+    }
     if (flags) {
         /* Unknown flag in the serialization */
         throw std::ios_base::failure("Unknown transaction optional data");
@@ -405,6 +447,13 @@ void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& p
 
     if (tx.IsBLSCT()) {
         s >> tx.txSig;
+        if (fCutThrough) {
+            s >> tx.vCutThrough;
+            if (!tx.HasCutThrough()) {
+                /* It's illegal to encode an empty list of cut-through terms. */
+                throw std::ios_base::failure("Superfluous cut-through record");
+            }
+        }
     }
 }
 
@@ -422,8 +471,11 @@ void SerializeTransaction(const TxType& tx, Stream& s, const TransactionSerParam
             flags |= 1;
         }
     }
+    if (tx.IsBLSCT() && tx.HasCutThrough()) {
+        flags |= 2;
+    }
     if (flags) {
-        /* Use extended format in case witnesses are to be serialized. */
+        /* Use extended format in case witnesses or cut-through terms are to be serialized. */
         std::vector<CTxIn> vinDummy;
         s << vinDummy;
         s << flags;
@@ -438,6 +490,9 @@ void SerializeTransaction(const TxType& tx, Stream& s, const TransactionSerParam
     s << tx.nLockTime;
     if (tx.IsBLSCT()) {
         s << tx.txSig;
+        if (flags & 2) {
+            s << tx.vCutThrough;
+        }
     }
 }
 
@@ -468,15 +523,22 @@ public:
     const int32_t nVersion;
     const uint32_t nLockTime;
     blsct::Signature txSig;
+    const std::vector<CTxCutThroughTerm> vCutThrough;
 
 private:
     /** Memory only. */
     const bool m_has_witness;
     const Txid hash;
     const Wtxid m_witness_hash;
+    /** Hashes of the inputs and outputs, as signed by BLSCT transactions.
+     *  Only computed for BLSCT transactions. */
+    const std::vector<uint256> m_in_hashes;
+    const std::vector<uint256> m_out_hashes;
 
     Txid ComputeHash() const;
     Wtxid ComputeWitnessHash() const;
+    std::vector<uint256> ComputeInHashes() const;
+    std::vector<uint256> ComputeOutHashes() const;
 
     bool ComputeHasWitness() const;
 
@@ -505,6 +567,11 @@ public:
     const Txid& GetHash() const LIFETIMEBOUND { return hash; }
     const Wtxid& GetWitnessHash() const LIFETIMEBOUND { return m_witness_hash; };
 
+    /** Return the hash of vin[n], same as vin[n].GetHash() */
+    uint256 GetInHash(size_t n) const { return n < m_in_hashes.size() ? m_in_hashes[n] : vin[n].GetHash(); }
+    /** Return the hash of vout[n], same as vout[n].GetHash() */
+    uint256 GetOutHash(size_t n) const { return n < m_out_hashes.size() ? m_out_hashes[n] : vout[n].GetHash(); }
+
     // Return sum of txouts.
     CAmount GetValueOut() const;
 
@@ -525,6 +592,11 @@ public:
         return nVersion & BLSCT_MARKER;
     }
 
+    bool HasCutThrough() const
+    {
+        return !vCutThrough.empty();
+    }
+
     friend bool operator==(const CTransaction& a, const CTransaction& b)
     {
         return a.hash == b.hash;
@@ -547,6 +619,7 @@ struct CMutableTransaction {
     int32_t nVersion;
     uint32_t nLockTime;
     blsct::Signature txSig;
+    std::vector<CTxCutThroughTerm> vCutThrough;
 
     explicit CMutableTransaction();
     explicit CMutableTransaction(const CTransaction& tx);
@@ -590,6 +663,11 @@ struct CMutableTransaction {
     {
         return nVersion & CTransaction::BLSCT_MARKER;
     }
+
+    bool HasCutThrough() const
+    {
+        return !vCutThrough.empty();
+    }
 };
 
 typedef std::shared_ptr<const CTransaction> CTransactionRef;
@@ -5,13 +5,16 @@
 
 #include <rest.h>
 
+#include <blsct/arith/mcl/mcl.h>
 #include <blockfilter.h>
 #include <chain.h>
 #include <chainparams.h>
+#include <common/json_writer.h>
 #include <core_io.h>
 #include <httpserver.h>
 #include <index/blockfilterindex.h>
 #include <index/txindex.h>
+#include <index/viewtagindex.h>
 #include <node/blockstorage.h>
 #include <node/context.h>
 #include <primitives/block.h>
@@ -29,8 +32,14 @@
 #include <util/strencodings.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <any>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <univalue.h>
 
@@ -39,6 +48,9 @@ using node::NodeContext;
 
 static const size_t MAX_GETUTXOS_OUTPOINTS = 15; //allow a max of 15 outpoints to be queried at once
 static constexpr unsigned int MAX_REST_HEADERS_RESULTS = 2000;
+static constexpr int MAX_REST_BLOCKRANGE_RESULTS = 1000;
+//! Number of staked commitment sets kept to answer delta requests
+static constexpr size_t MAX_STAKED_COMMITMENTS_SNAPSHOTS = 16;
 
 static const struct {
     RESTResponseFormat rf;
@@ -71,6 +83,19 @@ static bool RESTERR(HTTPRequest* req, enum HTTPStatusCode status, std::string me
     return false;
 }
 
+/**
+ * Reply with a JSON document that is written piece by piece, see
+ * HTTPReplyStream.
+ */
+static void WriteJSONReply(HTTPRequest* req, const std::function<void(common::JSONWriter&)>& write_json)
+{
+    HTTPReplyStream stream{req, "application/json"};
+    common::JSONWriter writer{[&](std::string&& text) { stream.Write(MakeByteSpan(text)); }};
+    write_json(writer);
+    stream.Write(MakeByteSpan(writer.Finish() + "\n"));
+    stream.Finish();
+}
+
 /**
  * Get the node context.
  *
@@ -291,7 +316,6 @@ static bool rest_block(const std::any& context,
     if (!ParseHashStr(hashStr, hash))
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
 
-    CBlock block;
     const CBlockIndex* pblockindex = nullptr;
     const CBlockIndex* tip = nullptr;
     ChainstateManager* maybe_chainman = GetChainman(context, req);
@@ -309,34 +333,36 @@ static bool rest_block(const std::any& context,
         }
     }
 
-    if (!chainman.m_blockman.ReadBlockFromDisk(block, *pblockindex)) {
-        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
-    }
-
     switch (rf) {
     case RESTResponseFormat::BINARY: {
-        DataStream ssBlock;
-        ssBlock << TX_WITH_WITNESS(block);
-        std::string binaryBlock = ssBlock.str();
+        const auto raw_block{chainman.m_blockman.ReadRawBlockCached(*pblockindex)};
+        if (!raw_block) {
+            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        }
         req->WriteHeader("Content-Type", "application/octet-stream");
-        req->WriteReply(HTTP_OK, binaryBlock);
+        req->WriteReply(HTTP_OK, std::string{raw_block->begin(), raw_block->end()});
         return true;
     }
 
     case RESTResponseFormat::HEX: {
-        DataStream ssBlock;
-        ssBlock << TX_WITH_WITNESS(block);
-        std::string strHex = HexStr(ssBlock) + "\n";
+        const auto raw_block{chainman.m_blockman.ReadRawBlockCached(*pblockindex)};
+        if (!raw_block) {
+            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        }
+        std::string strHex = HexStr(*raw_block) + "\n";
         req->WriteHeader("Content-Type", "text/plain");
         req->WriteReply(HTTP_OK, strHex);
         return true;
     }
 
     case RESTResponseFormat::JSON: {
-        UniValue objBlock = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity);
-        std::string strJSON = objBlock.write() + "\n";
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        const auto block{chainman.m_blockman.ReadBlockCached(*pblockindex)};
+        if (!block) {
+            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        }
+        WriteJSONReply(req, [&](common::JSONWriter& writer) {
+            blockToJSON(chainman.m_blockman, *block, *tip, *pblockindex, tx_verbosity, writer);
+        });
         return true;
     }
 
@@ -571,6 +597,346 @@ static bool rest_block_filter(const std::any& context, HTTPRequest* req, const s
     }
 }
 
+static bool rest_viewtags(const std::any& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req)) return false;
+
+    std::string height_str;
+    const RESTResponseFormat rf = ParseDataFormat(height_str, strURIPart);
+
+    int32_t start_height = -1;
+    if (!ParseInt32(height_str, &start_height) || start_height < 0) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid height: " + SanitizeString(height_str));
+    }
+
+    std::string raw_count;
+    try {
+        raw_count = req->GetQueryParameter("count").value_or("1");
+    } catch (const std::runtime_error& e) {
+        return RESTERR(req, HTTP_BAD_REQUEST, e.what());
+    }
+    const auto parsed_count{ToIntegral<int>(raw_count)};
+    if (!parsed_count.has_value() || *parsed_count < 1 || *parsed_count > MAX_VIEWTAG_LOOKUP_RANGE) {
+        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Block count is invalid or out of acceptable range (1-%d): %s", MAX_VIEWTAG_LOOKUP_RANGE, raw_count));
+    }
+
+    if (!g_viewtagindex) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Index is not enabled, start with -viewtagindex");
+    }
+
+    const CBlockIndex* stop_index;
+    {
+        ChainstateManager* maybe_chainman = GetChainman(context, req);
+        if (!maybe_chainman) return false;
+        ChainstateManager& chainman = *maybe_chainman;
+        LOCK(cs_main);
+        const CChain& active_chain = chainman.ActiveChain();
+        if (start_height > active_chain.Height()) {
+            return RESTERR(req, HTTP_NOT_FOUND, "Block height out of range");
+        }
+        stop_index = active_chain[std::min(start_height + *parsed_count - 1, active_chain.Height())];
+    }
+
+    bool index_ready = g_viewtagindex->BlockUntilSyncedToCurrentChain();
+
+    std::vector<ViewTagEntries> entries;
+    if (!g_viewtagindex->LookUpViewTags(start_height, stop_index, entries)) {
+        std::string errmsg = "View tags not found.";
+
+        if (!index_ready) {
+            errmsg += " Blocks are still in the process of being indexed.";
+        } else {
+            errmsg += " This error is unexpected and indicates index corruption.";
+        }
+
+        return RESTERR(req, HTTP_NOT_FOUND, errmsg);
+    }
+
+    switch (rf) {
+    case RESTResponseFormat::BINARY: {
+        DataStream ssResp{};
+        ssResp << entries;
+
+        std::string binaryResp = ssResp.str();
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteReply(HTTP_OK, binaryResp);
+        return true;
+    }
+    case RESTResponseFormat::HEX: {
+        DataStream ssResp{};
+        ssResp << entries;
+
+        std::string strHex = HexStr(ssResp) + "\n";
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, strHex);
+        return true;
+    }
+    case RESTResponseFormat::JSON: {
+        UniValue ret(UniValue::VARR);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            ret.push_back(viewTagEntriesToJSON(entries[i], start_height + i));
+        }
+        std::string strJSON = ret.write() + "\n";
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, strJSON);
+        return true;
+    }
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
+/**
+ * Parse the "<start>/<count>" part of a block range URI and look up the
+ * blocks of the active chain in that range, which must have their data.
+ * The range is cut short at the tip.
+ */
+static bool ParseBlockRange(ChainstateManager& chainman, HTTPRequest* req, const std::string& param, const std::string& name,
+                            std::vector<const CBlockIndex*>& blocks)
+{
+    const std::vector<std::string> uri_parts = SplitString(param, '/');
+    if (uri_parts.size() != 2) {
+        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Invalid URI format. Expected /rest/%s/<start>/<count>", name));
+    }
+
+    int32_t start_height = -1;
+    if (!ParseInt32(uri_parts[0], &start_height) || start_height < 0) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid height: " + SanitizeString(uri_parts[0]));
+    }
+    const auto parsed_count{ToIntegral<int>(uri_parts[1])};
+    if (!parsed_count.has_value() || *parsed_count < 1 || *parsed_count > MAX_REST_BLOCKRANGE_RESULTS) {
+        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Block count is invalid or out of acceptable range (1-%d): %s", MAX_REST_BLOCKRANGE_RESULTS, SanitizeString(uri_parts[1])));
+    }
+
+    LOCK(cs_main);
+    const CChain& active_chain = chainman.ActiveChain();
+    if (start_height > active_chain.Height()) {
+        return RESTERR(req, HTTP_NOT_FOUND, "Block height out of range");
+    }
+    const int stop_height{std::min(start_height + *parsed_count - 1, active_chain.Height())};
+    blocks.clear();
+    for (int height = start_height; height <= stop_height; ++height) {
+        const CBlockIndex* pindex{active_chain[height]};
+        if (chainman.m_blockman.IsBlockPruned(*pindex)) {
+            return RESTERR(req, HTTP_NOT_FOUND, pindex->GetBlockHash().GetHex() + " not available (pruned data)");
+        }
+        blocks.push_back(pindex);
+    }
+    return true;
+}
+
+static bool rest_block_range(const std::any& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req)) return false;
+
+    std::string param;
+    const RESTResponseFormat rf = ParseDataFormat(param, strURIPart);
+    if (rf != RESTResponseFormat::BINARY && rf != RESTResponseFormat::HEX) {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: .bin, .hex)");
+    }
+
+    ChainstateManager* maybe_chainman = GetChainman(context, req);
+    if (!maybe_chainman) return false;
+    ChainstateManager& chainman = *maybe_chainman;
+    std::vector<const CBlockIndex*> blocks;
+    if (!ParseBlockRange(chainman, req, param, "blockrange", blocks)) return false;
+
+    HTTPReplyStream stream{req, rf == RESTResponseFormat::BINARY ? "application/octet-stream" : "text/plain"};
+    // Blocks are stored in the same serialization as they are sent, so they
+    // are copied straight from the block files. Ranges don't populate the
+    // block cache so that they don't evict blocks requested one by one.
+    for (const CBlockIndex* pindex : blocks) {
+        const auto raw_block{chainman.m_blockman.ReadRawBlockCached(*pindex, /*populate=*/false)};
+        if (!raw_block) {
+            if (!stream.Started()) {
+                return RESTERR(req, HTTP_NOT_FOUND, pindex->GetBlockHash().GetHex() + " not found");
+            }
+            // Part of the range has been sent already, end the reply early.
+            break;
+        }
+        if (!stream.Write(rf == RESTResponseFormat::BINARY ? MakeByteSpan(*raw_block) : MakeByteSpan(HexStr(*raw_block)))) break;
+    }
+    if (rf == RESTResponseFormat::HEX) stream.Write(MakeByteSpan(std::string{"\n"}));
+    stream.Finish();
+    return true;
+}
+
+/**
+ * The keys and commitments of the BLSCT outputs of a block, stored column
+ * by column like ViewTagEntries.
+ */
+struct BLSCTOutputEntries {
+    uint256 block_hash;
+    std::vector<COutPoint> outpoints;
+    std::vector<MclG1Point> commitments;
+    std::vector<MclG1Point> spending_keys;
+    std::vector<MclG1Point> blinding_keys;
+    std::vector<MclG1Point> ephemeral_keys;
+    std::vector<uint16_t> view_tags;
+
+    SERIALIZE_METHODS(BLSCTOutputEntries, obj)
+    {
+        READWRITE(obj.block_hash, obj.outpoints, obj.commitments, obj.spending_keys, obj.blinding_keys, obj.ephemeral_keys, obj.view_tags);
+    }
+};
+
+static bool rest_blsct_outputs(const std::any& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req)) return false;
+
+    std::string param;
+    const RESTResponseFormat rf = ParseDataFormat(param, strURIPart);
+    if (rf != RESTResponseFormat::BINARY && rf != RESTResponseFormat::HEX) {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: .bin, .hex)");
+    }
+
+    ChainstateManager* maybe_chainman = GetChainman(context, req);
+    if (!maybe_chainman) return false;
+    ChainstateManager& chainman = *maybe_chainman;
+    std::vector<const CBlockIndex*> blocks;
+    if (!ParseBlockRange(chainman, req, param, "blsctoutputs", blocks)) return false;
+
+    HTTPReplyStream stream{req, rf == RESTResponseFormat::BINARY ? "application/octet-stream" : "text/plain"};
+    for (const CBlockIndex* pindex : blocks) {
+        const auto block{chainman.m_blockman.ReadBlockCached(*pindex, /*populate=*/false)};
+        if (!block) {
+            if (!stream.Started()) {
+                return RESTERR(req, HTTP_NOT_FOUND, pindex->GetBlockHash().GetHex() + " not found");
+            }
+            // Part of the range has been sent already, end the reply early.
+            break;
+        }
+
+        BLSCTOutputEntries entries;
+        entries.block_hash = pindex->GetBlockHash();
+        for (const auto& tx : block->vtx) {
+            for (uint32_t n = 0; n < tx->vout.size(); ++n) {
+                const CTxOut& out = tx->vout[n];
+                if (!out.IsBLSCT()) continue;
+                entries.outpoints.emplace_back(tx->GetHash(), n);
+                entries.commitments.push_back(out.blsctData.rangeProof.Vs[0]);
+                entries.spending_keys.push_back(out.blsctData.spendingKey);
+                entries.blinding_keys.push_back(out.blsctData.blindingKey);
+                entries.ephemeral_keys.push_back(out.blsctData.ephemeralKey);
+                entries.view_tags.push_back(out.blsctData.viewTag);
+            }
+        }
+
+        DataStream ssEntries{};
+        ssEntries << entries;
+        if (!stream.Write(rf == RESTResponseFormat::BINARY ? MakeByteSpan(ssEntries) : MakeByteSpan(HexStr(ssEntries)))) break;
+    }
+    if (rf == RESTResponseFormat::HEX) stream.Write(MakeByteSpan(std::string{"\n"}));
+    stream.Finish();
+    return true;
+}
+
+using StakedCommitmentsSnapshot = std::shared_ptr<const std::vector<MclG1Point>>;
+
+static GlobalMutex g_staked_commitments_mutex;
+//! Recent staked commitment sets keyed by the tip they were taken at, newest first
+static std::deque<std::pair<uint256, StakedCommitmentsSnapshot>> g_staked_commitments_snapshots GUARDED_BY(g_staked_commitments_mutex);
+
+static StakedCommitmentsSnapshot FindStakedCommitmentsSnapshot(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(g_staked_commitments_mutex)
+{
+    for (const auto& [snapshot_hash, snapshot] : g_staked_commitments_snapshots) {
+        if (snapshot_hash == hash) return snapshot;
+    }
+    return nullptr;
+}
+
+static bool rest_staked_commitments(const std::any& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req)) return false;
+
+    std::string param;
+    const RESTResponseFormat rf = ParseDataFormat(param, strURIPart);
+
+    // request is sent over URI scheme /rest/stakedcommitments[/snapshot]
+    uint256 base_hash;
+    if (!param.empty() && (param[0] != '/' || !ParseHashStr(param.substr(1), base_hash))) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Expected /rest/stakedcommitments[/<snapshot>]");
+    }
+
+    ChainstateManager* maybe_chainman = GetChainman(context, req);
+    if (!maybe_chainman) return false;
+    ChainstateManager& chainman = *maybe_chainman;
+
+    // The staked set only changes with the tip, so the tip hash identifies it
+    uint256 snapshot_hash;
+    StakedCommitmentsSnapshot snapshot;
+    StakedCommitmentsSnapshot base;
+    {
+        LOCK2(cs_main, g_staked_commitments_mutex);
+        snapshot_hash = chainman.ActiveChain().Tip()->GetBlockHash();
+        snapshot = FindStakedCommitmentsSnapshot(snapshot_hash);
+        if (!snapshot) {
+            snapshot = std::make_shared<const std::vector<MclG1Point>>(chainman.ActiveChainstate().CoinsTip().GetStakedCommitments().GetElements().m_vec);
+            g_staked_commitments_snapshots.emplace_front(snapshot_hash, snapshot);
+            if (g_staked_commitments_snapshots.size() > MAX_STAKED_COMMITMENTS_SNAPSHOTS) {
+                g_staked_commitments_snapshots.pop_back();
+            }
+        }
+        if (!base_hash.IsNull()) base = FindStakedCommitmentsSnapshot(base_hash);
+    }
+
+    // Unknown or expired snapshots are answered with the full set and a null base
+    std::vector<MclG1Point> added;
+    std::vector<MclG1Point> removed;
+    if (base) {
+        std::set_difference(snapshot->begin(), snapshot->end(), base->begin(), base->end(), std::back_inserter(added));
+        std::set_difference(base->begin(), base->end(), snapshot->begin(), snapshot->end(), std::back_inserter(removed));
+    } else {
+        base_hash.SetNull();
+        added = *snapshot;
+    }
+
+    switch (rf) {
+    case RESTResponseFormat::BINARY: {
+        DataStream ssResp{};
+        ssResp << snapshot_hash << base_hash << added << removed;
+
+        std::string binaryResp = ssResp.str();
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteReply(HTTP_OK, binaryResp);
+        return true;
+    }
+    case RESTResponseFormat::HEX: {
+        DataStream ssResp{};
+        ssResp << snapshot_hash << base_hash << added << removed;
+
+        std::string strHex = HexStr(ssResp) + "\n";
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, strHex);
+        return true;
+    }
+    case RESTResponseFormat::JSON: {
+        UniValue added_json(UniValue::VARR);
+        for (const auto& point : added) {
+            added_json.push_back(HexStr(point.GetVch()));
+        }
+        UniValue removed_json(UniValue::VARR);
+        for (const auto& point : removed) {
+            removed_json.push_back(HexStr(point.GetVch()));
+        }
+
+        UniValue ret(UniValue::VOBJ);
+        ret.pushKV("snapshot", snapshot_hash.GetHex());
+        ret.pushKV("base", base_hash.IsNull() ? UniValue() : UniValue(base_hash.GetHex()));
+        ret.pushKV("added", added_json);
+        ret.pushKV("removed", removed_json);
+        std::string strJSON = ret.write() + "\n";
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, strJSON);
+        return true;
+    }
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
 // A bit of a hack - dependency on a function defined in rpc/blockchain.cpp
 RPCHelpMan getblockchaininfo();
 
@@ -681,9 +1047,13 @@ static bool rest_mempool(const std::any& context, HTTPRequest* req, const std::s
             if (verbose && mempool_sequence) {
                 return RESTERR(req, HTTP_BAD_REQUEST, "Verbose results cannot contain mempool sequence values. (hint: set \"verbose=false\")");
             }
+            if (verbose) {
+                WriteJSONReply(req, [&](common::JSONWriter& writer) { MempoolToJSON(*mempool, writer); });
+                return true;
+            }
             str_json = MempoolToJSON(*mempool, verbose, mempool_sequence).write() + "\n";
         } else {
-            str_json = MempoolInfoToJSON(*mempool).write() + "\n";
+            str_json = MempoolInfoToJSON(*mempool, util::AnyPtr<NodeContext>(context)->peerman.get()).write() + "\n";
         }
 
         req->WriteHeader("Content-Type", "application/json");
@@ -1000,26 +1370,31 @@ static bool rest_blockhash_by_height(const std::any& context, HTTPRequest* req,
 static const struct {
     const char* prefix;
     bool (*handler)(const std::any& context, HTTPRequest* req, const std::string& strReq);
+    HTTPRequestCost cost;
 } uri_prefixes[] = {
-      {"/rest/tx/", rest_tx},
-      {"/rest/block/notxdetails/", rest_block_notxdetails},
-      {"/rest/block/", rest_block_extended},
-      {"/rest/blockfilter/", rest_block_filter},
-      {"/rest/blockfilterheaders/", rest_filter_header},
-      {"/rest/chaininfo", rest_chaininfo},
-      {"/rest/mempool/", rest_mempool},
-      {"/rest/headers/", rest_headers},
-      {"/rest/getutxos", rest_getutxos},
-      {"/rest/deploymentinfo/", rest_deploymentinfo},
-      {"/rest/deploymentinfo", rest_deploymentinfo},
-      {"/rest/blockhashbyheight/", rest_blockhash_by_height},
+      {"/rest/tx/", rest_tx, HTTPRequestCost::NORMAL},
+      {"/rest/block/notxdetails/", rest_block_notxdetails, HTTPRequestCost::HIGH},
+      {"/rest/block/", rest_block_extended, HTTPRequestCost::HIGH},
+      {"/rest/blockfilter/", rest_block_filter, HTTPRequestCost::NORMAL},
+      {"/rest/blockfilterheaders/", rest_filter_header, HTTPRequestCost::NORMAL},
+      {"/rest/chaininfo", rest_chaininfo, HTTPRequestCost::NORMAL},
+      {"/rest/mempool/", rest_mempool, HTTPRequestCost::HIGH},
+      {"/rest/headers/", rest_headers, HTTPRequestCost::NORMAL},
+      {"/rest/getutxos", rest_getutxos, HTTPRequestCost::NORMAL},
+      {"/rest/deploymentinfo/", rest_deploymentinfo, HTTPRequestCost::NORMAL},
+      {"/rest/deploymentinfo", rest_deploymentinfo, HTTPRequestCost::NORMAL},
+      {"/rest/blockhashbyheight/", rest_blockhash_by_height, HTTPRequestCost::NORMAL},
+      {"/rest/stakedcommitments", rest_staked_commitments, HTTPRequestCost::NORMAL},
+      {"/rest/viewtags/", rest_viewtags, HTTPRequestCost::HIGH},
+      {"/rest/blockrange/", rest_block_range, HTTPRequestCost::HIGH},
+      {"/rest/blsctoutputs/", rest_blsct_outputs, HTTPRequestCost::HIGH},
 };
 
 void StartREST(const std::any& context)
 {
     for (const auto& up : uri_prefixes) {
         auto handler = [context, up](HTTPRequest* req, const std::string& prefix) { return up.handler(context, req, prefix); };
-        RegisterHTTPHandler(up.prefix, false, handler);
+        RegisterHTTPHandler(up.prefix, false, handler, up.cost);
     }
 }
 
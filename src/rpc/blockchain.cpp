@@ -11,6 +11,7 @@
 #include <clientversion.h>
 #include <coins.h>
 #include <common/args.h>
+#include <common/json_writer.h>
 #include <consensus/amount.h>
 #include <consensus/params.h>
 #include <consensus/validation.h>
@@ -20,6 +21,7 @@
 #include <hash.h>
 #include <index/blockfilterindex.h>
 #include <index/coinstatsindex.h>
+#include <index/viewtagindex.h>
 #include <kernel/coinstats.h>
 #include <logging/timer.h>
 #include <net.h>
@@ -50,15 +52,24 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 using kernel::CCoinsStats;
 using kernel::CoinStatsHashType;
 
+using node::BlockCache;
 using node::BlockManager;
+using node::MAX_SNAPSHOT_THREADS;
 using node::NodeContext;
+using node::SNAPSHOT_CHUNK_COINS;
+using node::SnapshotChunk;
 using node::SnapshotMetadata;
 
 struct CUpdatedBlock
@@ -148,6 +159,26 @@ static const CBlockIndex* ParseHashOrHeight(const UniValue& param, ChainstateMan
     }
 }
 
+UniValue viewTagEntriesToJSON(const ViewTagEntries& entries, int height)
+{
+    UniValue outputs(UniValue::VARR);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        UniValue output(UniValue::VOBJ);
+        output.pushKV("viewtag", entries.view_tags[i]);
+        output.pushKV("blindingkey", HexStr(entries.blinding_keys[i]));
+        output.pushKV("txid", entries.outpoints[i].hash.GetHex());
+        output.pushKV("vout", entries.outpoints[i].n);
+        output.pushKV("spendingkey", HexStr(entries.spending_keys[i]));
+        outputs.push_back(output);
+    }
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("height", height);
+    result.pushKV("hash", entries.block_hash.GetHex());
+    result.pushKV("outputs", outputs);
+    return result;
+}
+
 UniValue blockheaderToJSON(const CBlockIndex& tip, const CBlockIndex& blockindex)
 {
     // Serialize passed information without accessing chain state of the active chain!
@@ -178,19 +209,24 @@ UniValue blockheaderToJSON(const CBlockIndex& tip, const CBlockIndex& blockindex
     return result;
 }
 
-UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity)
+//! Block description to JSON, except for the transactions
+static UniValue blockSummaryToJSON(const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex)
 {
     UniValue result = blockheaderToJSON(tip, blockindex);
 
     result.pushKV("strippedsize", (int)::GetSerializeSize(TX_NO_WITNESS(block)));
     result.pushKV("size", (int)::GetSerializeSize(TX_WITH_WITNESS(block)));
     result.pushKV("weight", (int)::GetBlockWeight(block));
-    UniValue txs(UniValue::VARR);
+    return result;
+}
 
+//! Pass the JSON of each transaction of the block to fn, in block order
+static void blockTxsToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& blockindex, TxVerbosity verbosity, const std::function<void(UniValue&&)>& fn)
+{
     switch (verbosity) {
         case TxVerbosity::SHOW_TXID:
             for (const CTransactionRef& tx : block.vtx) {
-                txs.push_back(tx->GetHash().GetHex());
+                fn(tx->GetHash().GetHex());
             }
             break;
 
@@ -206,16 +242,36 @@ UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIn
                 const CTxUndo* txundo = (have_undo && i > 0) ? &blockUndo.vtxundo.at(i - 1) : nullptr;
                 UniValue objTx(UniValue::VOBJ);
                 TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true, txundo, verbosity);
-                txs.push_back(objTx);
+                fn(std::move(objTx));
             }
             break;
     }
+}
 
-    result.pushKV("tx", txs);
+UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity)
+{
+    UniValue result = blockSummaryToJSON(block, tip, blockindex);
+
+    UniValue txs(UniValue::VARR);
+    blockTxsToJSON(blockman, block, blockindex, verbosity, [&](UniValue&& tx) { txs.push_back(std::move(tx)); });
+    result.pushKV("tx", std::move(txs));
 
     return result;
 }
 
+void blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity, common::JSONWriter& writer)
+{
+    writer.BeginObject();
+    writer.Members(blockSummaryToJSON(block, tip, blockindex));
+
+    writer.Key("tx");
+    writer.BeginArray();
+    blockTxsToJSON(blockman, block, blockindex, verbosity, [&](UniValue&& tx) { writer.Value(tx); });
+    writer.EndArray();
+
+    writer.EndObject();
+}
+
 static RPCHelpMan getblockcount()
 {
     return RPCHelpMan{"getblockcount",
@@ -234,6 +290,7 @@ static RPCHelpMan getblockcount()
     LOCK(cs_main);
     return chainman.ActiveChain().Height();
 },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -254,6 +311,7 @@ static RPCHelpMan getbestblockhash()
     LOCK(cs_main);
     return chainman.ActiveChain().Tip()->GetBlockHash().GetHex();
 },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -519,6 +577,7 @@ static RPCHelpMan getblockhash()
     const CBlockIndex* pblockindex = active_chain[nHeight];
     return pblockindex->GetBlockHash().GetHex();
 },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -589,20 +648,24 @@ static RPCHelpMan getblockheader()
 
             return blockheaderToJSON(*tip, *pblockindex);
         },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
-static CBlock GetBlockChecked(BlockManager& blockman, const CBlockIndex& blockindex)
+static void CheckBlockNotPruned(BlockManager& blockman, const CBlockIndex& blockindex)
 {
-    CBlock block;
-    {
-        LOCK(cs_main);
-        if (blockman.IsBlockPruned(blockindex)) {
-            throw JSONRPCError(RPC_MISC_ERROR, "Block not available (pruned data)");
-        }
+    LOCK(cs_main);
+    if (blockman.IsBlockPruned(blockindex)) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Block not available (pruned data)");
     }
+}
 
-    if (!blockman.ReadBlockFromDisk(block, blockindex)) {
+static std::shared_ptr<const CBlock> GetBlockChecked(BlockManager& blockman, const CBlockIndex& blockindex, bool populate_cache = true)
+{
+    CheckBlockNotPruned(blockman, blockindex);
+
+    auto block{blockman.ReadBlockCached(blockindex, populate_cache)};
+    if (!block) {
         // Block not found on disk. This could be because we have the block
         // header in our index but not yet have the block or did not accept the
         // block. Or if the block was pruned right after we released the lock above.
@@ -612,6 +675,18 @@ static CBlock GetBlockChecked(BlockManager& blockman, const CBlockIndex& blockin
     return block;
 }
 
+static std::shared_ptr<const std::vector<uint8_t>> GetRawBlockChecked(BlockManager& blockman, const CBlockIndex& blockindex)
+{
+    CheckBlockNotPruned(blockman, blockindex);
+
+    auto raw_block{blockman.ReadRawBlockCached(blockindex)};
+    if (!raw_block) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Block not found on disk");
+    }
+
+    return raw_block;
+}
+
 static CBlockUndo GetUndoChecked(BlockManager& blockman, const CBlockIndex& blockindex)
 {
     CBlockUndo blockUndo;
@@ -752,15 +827,12 @@ static RPCHelpMan getblock()
         }
     }
 
-    const CBlock block{GetBlockChecked(chainman.m_blockman, *pblockindex)};
-
     if (verbosity <= 0) {
-        DataStream ssBlock;
-        ssBlock << TX_WITH_WITNESS(block);
-        std::string strHex = HexStr(ssBlock);
-        return strHex;
+        return HexStr(*GetRawBlockChecked(chainman.m_blockman, *pblockindex));
     }
 
+    const auto block{GetBlockChecked(chainman.m_blockman, *pblockindex)};
+
     TxVerbosity tx_verbosity;
     if (verbosity == 1) {
         tx_verbosity = TxVerbosity::SHOW_TXID;
@@ -770,8 +842,60 @@ static RPCHelpMan getblock()
         tx_verbosity = TxVerbosity::SHOW_DETAILS_AND_PREVOUT;
     }
 
-    return blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity);
+    if (request.result_writer) {
+        // Send the transactions as they are converted instead of holding the
+        // JSON of the whole block.
+        blockToJSON(chainman.m_blockman, *block, *tip, *pblockindex, tx_verbosity, *request.result_writer);
+        return UniValue{};
+    }
+    return blockToJSON(chainman.m_blockman, *block, *tip, *pblockindex, tx_verbosity);
+},
+        RPCMethodOptions{.parallel_batch = true},
+    };
+}
+
+static RPCHelpMan getblockcacheinfo()
+{
+    return RPCHelpMan{"getblockcacheinfo",
+                "\nReturns statistics of the cache of recently read blocks (see -blockcachesize).\n"
+                "The cache is shared by getblock, the REST interface and serving blocks to peers. A block can be\n"
+                "cached deserialized, serialized or both, and lookups of each form are counted separately.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::NUM, "entries", "Number of cached blocks"},
+                        {RPCResult::Type::NUM, "usage", "Estimated memory usage of the cache in bytes"},
+                        {RPCResult::Type::NUM, "max_usage", "Maximum memory usage of the cache in bytes"},
+                        {RPCResult::Type::NUM, "block_hits", "Lookups of deserialized blocks served from the cache"},
+                        {RPCResult::Type::NUM, "block_misses", "Lookups of deserialized blocks not found in the cache"},
+                        {RPCResult::Type::NUM, "raw_hits", "Lookups of serialized blocks served from the cache"},
+                        {RPCResult::Type::NUM, "raw_misses", "Lookups of serialized blocks not found in the cache"},
+                        {RPCResult::Type::NUM, "hit_rate", "Fraction of all lookups served from the cache (0 if there were none)"},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getblockcacheinfo", "")
+            + HelpExampleRpc("getblockcacheinfo", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    const BlockCache::Stats stats{chainman.m_blockman.GetBlockCacheStats()};
+    const uint64_t hits{stats.block_hits + stats.raw_hits};
+    const uint64_t lookups{hits + stats.block_misses + stats.raw_misses};
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("entries", uint64_t(stats.entries));
+    ret.pushKV("usage", uint64_t(stats.usage));
+    ret.pushKV("max_usage", uint64_t(stats.max_usage));
+    ret.pushKV("block_hits", stats.block_hits);
+    ret.pushKV("block_misses", stats.block_misses);
+    ret.pushKV("raw_hits", stats.raw_hits);
+    ret.pushKV("raw_misses", stats.raw_misses);
+    ret.pushKV("hit_rate", lookups ? double(hits) / lookups : 0.0);
+    return ret;
 },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -835,7 +959,7 @@ static RPCHelpMan pruneblockchain()
 
 CoinStatsHashType ParseHashType(const std::string& hash_type_input)
 {
-    if (hash_type_input == "hash_serialized_3") {
+    if (hash_type_input == "hash_serialized_4") {
         return CoinStatsHashType::HASH_SERIALIZED;
     } else if (hash_type_input == "muhash") {
         return CoinStatsHashType::MUHASH;
@@ -882,7 +1006,7 @@ static RPCHelpMan gettxoutsetinfo()
                 "\nReturns statistics about the unspent transaction output set.\n"
                 "Note this call may take some time if you are not using coinstatsindex.\n",
                 {
-                    {"hash_type", RPCArg::Type::STR, RPCArg::Default{"hash_serialized_3"}, "Which UTXO set hash should be calculated. Options: 'hash_serialized_3' (the legacy algorithm), 'muhash', 'none'."},
+                    {"hash_type", RPCArg::Type::STR, RPCArg::Default{"hash_serialized_4"}, "Which UTXO set hash should be calculated. Options: 'hash_serialized_4' (the legacy algorithm), 'muhash', 'none'."},
                     {"hash_or_height", RPCArg::Type::NUM, RPCArg::DefaultHint{"the current best block"}, "The block hash or height of the target height (only available with coinstatsindex).",
                      RPCArgOptions{
                          .skip_type_check = true,
@@ -897,10 +1021,11 @@ static RPCHelpMan gettxoutsetinfo()
                         {RPCResult::Type::STR_HEX, "bestblock", "The hash of the block at which these statistics are calculated"},
                         {RPCResult::Type::NUM, "txouts", "The number of unspent transaction outputs"},
                         {RPCResult::Type::NUM, "bogosize", "Database-independent, meaningless metric indicating the UTXO set size"},
-                        {RPCResult::Type::STR_HEX, "hash_serialized_3", /*optional=*/true, "The serialized hash (only present if 'hash_serialized_3' hash_type is chosen)"},
+                        {RPCResult::Type::STR_HEX, "hash_serialized_4", /*optional=*/true, "The serialized hash (only present if 'hash_serialized_4' hash_type is chosen)"},
                         {RPCResult::Type::STR_HEX, "muhash", /*optional=*/true, "The serialized hash (only present if 'muhash' hash_type is chosen)"},
                         {RPCResult::Type::NUM, "transactions", /*optional=*/true, "The number of transactions with unspent outputs (not available when coinstatsindex is used)"},
                         {RPCResult::Type::NUM, "disk_size", /*optional=*/true, "The estimated size of the chainstate on disk (not available when coinstatsindex is used)"},
+                        {RPCResult::Type::NUM, "cache_usage", /*optional=*/true, "The memory usage of the UTXO cache in bytes before it was flushed to compute these statistics (not available when coinstatsindex is used)"},
                         {RPCResult::Type::STR_AMOUNT, "total_amount", "The total amount of coins in the UTXO set"},
                         {RPCResult::Type::STR_AMOUNT, "total_unspendable_amount", /*optional=*/true, "The total amount of coins permanently excluded from the UTXO set (only available if coinstatsindex is used)"},
                         {RPCResult::Type::OBJ, "block_info", /*optional=*/true, "Info on amounts in the block at this block height (only available if coinstatsindex is used)",
@@ -940,6 +1065,7 @@ static RPCHelpMan gettxoutsetinfo()
     NodeContext& node = EnsureAnyNodeContext(request.context);
     ChainstateManager& chainman = EnsureChainman(node);
     Chainstate& active_chainstate = chainman.ActiveChainstate();
+    const size_t cache_usage{WITH_LOCK(::cs_main, return active_chainstate.CoinsTip().DynamicMemoryUsage())};
     active_chainstate.ForceFlushStateToDisk();
 
     CCoinsView* coins_view;
@@ -957,7 +1083,7 @@ static RPCHelpMan gettxoutsetinfo()
         }
 
         if (hash_type == CoinStatsHashType::HASH_SERIALIZED) {
-            throw JSONRPCError(RPC_INVALID_PARAMETER, "hash_serialized_3 hash type cannot be queried for a specific block");
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "hash_serialized_4 hash type cannot be queried for a specific block");
         }
 
         if (!index_requested) {
@@ -986,7 +1112,7 @@ static RPCHelpMan gettxoutsetinfo()
         ret.pushKV("txouts", (int64_t)stats.nTransactionOutputs);
         ret.pushKV("bogosize", (int64_t)stats.nBogoSize);
         if (hash_type == CoinStatsHashType::HASH_SERIALIZED) {
-            ret.pushKV("hash_serialized_3", stats.hashSerialized.GetHex());
+            ret.pushKV("hash_serialized_4", stats.hashSerialized.GetHex());
         }
         if (hash_type == CoinStatsHashType::MUHASH) {
             ret.pushKV("muhash", stats.hashSerialized.GetHex());
@@ -996,6 +1122,7 @@ static RPCHelpMan gettxoutsetinfo()
         if (!stats.index_used) {
             ret.pushKV("transactions", static_cast<int64_t>(stats.nTransactions));
             ret.pushKV("disk_size", stats.nDiskSize);
+            ret.pushKV("cache_usage", (uint64_t)cache_usage);
         } else {
             ret.pushKV("total_unspendable_amount", ValueFromAmount(stats.total_unspendable_amount));
 
@@ -1110,6 +1237,7 @@ static RPCHelpMan gettxout()
 
     return ret;
 },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -1828,7 +1956,8 @@ static RPCHelpMan getblockstats()
         }
     }
 
-    const CBlock& block = GetBlockChecked(chainman.m_blockman, pindex);
+    const auto pblock{GetBlockChecked(chainman.m_blockman, pindex)};
+    const CBlock& block{*pblock};
     const CBlockUndo& blockUndo = GetUndoChecked(chainman.m_blockman, pindex);
 
     const bool do_all = stats.size() == 0; // Calculate everything if nothing selected (default)
@@ -2288,11 +2417,11 @@ public:
 
 static bool CheckBlockFilterMatches(BlockManager& blockman, const CBlockIndex& blockindex, const GCSFilter::ElementSet& needles)
 {
-    const CBlock block{GetBlockChecked(blockman, blockindex)};
+    const auto block{GetBlockChecked(blockman, blockindex, /*populate_cache=*/false)};
     const CBlockUndo block_undo{GetUndoChecked(blockman, blockindex)};
 
     // Check if any of the outputs match the scriptPubKey
-    for (const auto& tx : block.vtx) {
+    for (const auto& tx : block->vtx) {
         if (std::any_of(tx->vout.cbegin(), tx->vout.cend(), [&](const auto& txout) {
                 return needles.count(std::vector<unsigned char>(txout.scriptPubKey.begin(), txout.scriptPubKey.end())) != 0;
             })) {
@@ -2575,6 +2704,83 @@ static RPCHelpMan getblockfilter()
     ret.pushKV("header", filter_header.GetHex());
     return ret;
 },
+        RPCMethodOptions{.parallel_batch = true},
+    };
+}
+
+static RPCHelpMan getviewtags()
+{
+    return RPCHelpMan{"getviewtags",
+                "\nReturns the view tag, blinding key, outpoint and spending key of every BLSCT output in a range of blocks.\n"
+                "Requires -viewtagindex.\n",
+                {
+                    {"height", RPCArg::Type::NUM, RPCArg::Optional::NO, "The height of the first block"},
+                    {"count", RPCArg::Type::NUM, RPCArg::Default{1}, strprintf("The number of blocks to return (1-%d)", MAX_VIEWTAG_LOOKUP_RANGE)},
+                },
+                RPCResult{
+                    RPCResult::Type::ARR, "", "",
+                    {
+                        {RPCResult::Type::OBJ, "", "",
+                        {
+                            {RPCResult::Type::NUM, "height", "The block height"},
+                            {RPCResult::Type::STR_HEX, "hash", "The block hash"},
+                            {RPCResult::Type::ARR, "outputs", "The BLSCT outputs of the block, in block order",
+                            {
+                                {RPCResult::Type::OBJ, "", "",
+                                {
+                                    {RPCResult::Type::NUM, "viewtag", "The output's view tag"},
+                                    {RPCResult::Type::STR_HEX, "blindingkey", "The output's blinding key"},
+                                    {RPCResult::Type::STR_HEX, "txid", "The transaction id"},
+                                    {RPCResult::Type::NUM, "vout", "The output index"},
+                                    {RPCResult::Type::STR_HEX, "spendingkey", "The output's spending key"},
+                                }},
+                            }},
+                        }},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getviewtags", "1000 10") +
+                    HelpExampleRpc("getviewtags", "1000, 10")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    if (!g_viewtagindex) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Requires -viewtagindex");
+    }
+
+    const int height{request.params[0].getInt<int>()};
+    const int count{request.params[1].isNull() ? 1 : request.params[1].getInt<int>()};
+    if (count < 1 || count > MAX_VIEWTAG_LOOKUP_RANGE) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Count is out of range (1-%d)", MAX_VIEWTAG_LOOKUP_RANGE));
+    }
+
+    const CBlockIndex* stop_index;
+    {
+        ChainstateManager& chainman = EnsureAnyChainman(request.context);
+        LOCK(cs_main);
+        const CChain& active_chain = chainman.ActiveChain();
+        if (height < 0 || height > active_chain.Height()) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Block height out of range");
+        }
+        stop_index = active_chain[std::min(height + count - 1, active_chain.Height())];
+    }
+
+    bool index_ready = g_viewtagindex->BlockUntilSyncedToCurrentChain();
+
+    std::vector<ViewTagEntries> entries;
+    if (!g_viewtagindex->LookUpViewTags(height, stop_index, entries)) {
+        if (!index_ready) {
+            throw JSONRPCError(RPC_MISC_ERROR, "View tags not found. Blocks are still in the process of being indexed.");
+        }
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "View tags not found. This error is unexpected and indicates index corruption.");
+    }
+
+    UniValue ret(UniValue::VARR);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        ret.push_back(viewTagEntriesToJSON(entries[i], height + i));
+    }
+    return ret;
+},
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -2648,6 +2854,7 @@ UniValue CreateUTXOSnapshot(
 {
     std::unique_ptr<CCoinsViewCursor> pcursor;
     std::optional<CCoinsStats> maybe_stats;
+    OrderedElements<MclG1Point> staked_commitments;
     const CBlockIndex* tip;
 
     {
@@ -2673,6 +2880,7 @@ UniValue CreateUTXOSnapshot(
         }
 
         pcursor = chainstate.CoinsDB().Cursor();
+        staked_commitments = chainstate.CoinsDB().GetStakedCommitments();
         tip = CHECK_NONFATAL(chainstate.m_blockman.LookupBlockIndex(maybe_stats->hashBlock));
     }
 
@@ -2680,10 +2888,28 @@ UniValue CreateUTXOSnapshot(
         tip->nHeight, tip->GetBlockHash().ToString(),
         fs::PathToString(path), fs::PathToString(temppath)));
 
-    SnapshotMetadata metadata{tip->GetBlockHash(), maybe_stats->coins_count};
+    SnapshotMetadata metadata{tip->GetBlockHash(), maybe_stats->coins_count, std::move(staked_commitments)};
 
     afile << metadata;
 
+    // Chunks of coins are serialized and checksummed on worker threads while
+    // this thread reads the cursor and writes the finished chunks in order.
+    const size_t max_pending_chunks = std::clamp<int>(std::thread::hardware_concurrency(), 1, MAX_SNAPSHOT_THREADS);
+    std::deque<std::future<SnapshotChunk>> pending_chunks;
+    std::vector<std::pair<COutPoint, Coin>> coins;
+    coins.reserve(SNAPSHOT_CHUNK_COINS);
+
+    const auto write_chunk = [&] {
+        afile << pending_chunks.front().get();
+        pending_chunks.pop_front();
+    };
+    const auto queue_chunk = [&] {
+        if (pending_chunks.size() >= max_pending_chunks) write_chunk();
+        pending_chunks.push_back(std::async(std::launch::async, [coins = std::move(coins)] { return SnapshotChunk{coins}; }));
+        coins.clear();
+        coins.reserve(SNAPSHOT_CHUNK_COINS);
+    };
+
     COutPoint key;
     Coin coin;
     unsigned int iter{0};
@@ -2692,12 +2918,14 @@ UniValue CreateUTXOSnapshot(
         if (iter % 5000 == 0) node.rpc_interruption_point();
         ++iter;
         if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
-            afile << key;
-            afile << coin;
+            coins.emplace_back(key, std::move(coin));
+            if (coins.size() >= SNAPSHOT_CHUNK_COINS) queue_chunk();
         }
 
         pcursor->Next();
     }
+    if (!coins.empty()) queue_chunk();
+    while (!pending_chunks.empty()) write_chunk();
 
     afile.fclose();
 
@@ -2762,7 +2990,11 @@ static RPCHelpMan loadtxoutset()
     }
 
     SnapshotMetadata metadata;
-    afile >> metadata;
+    try {
+        afile >> metadata;
+    } catch (const std::ios_base::failure& e) {
+        throw JSONRPCError(RPC_DESERIALIZATION_ERROR, strprintf("Unable to parse metadata: %s", e.what()));
+    }
 
     uint256 base_blockhash = metadata.m_base_blockhash;
     if (!chainman.GetParams().AssumeutxoForBlockhash(base_blockhash).has_value()) {
@@ -2891,6 +3123,7 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"blockchain", &getbestblockhash},
         {"blockchain", &getblockcount},
         {"blockchain", &getblock},
+        {"blockchain", &getblockcacheinfo},
         {"blockchain", &getblockfrompeer},
         {"blockchain", &getblockhash},
         {"blockchain", &getblockheader},
@@ -2905,6 +3138,7 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"blockchain", &scantxoutset},
         {"blockchain", &scanblocks},
         {"blockchain", &getblockfilter},
+        {"blockchain", &getviewtags},
         {"blockchain", &dumptxoutset},
         {"blockchain", &loadtxoutset},
         {"blockchain", &getchainstates},
@@ -20,6 +20,10 @@ class CBlock;
 class CBlockIndex;
 class Chainstate;
 class UniValue;
+struct ViewTagEntries;
+namespace common {
+class JSONWriter;
+} // namespace common
 namespace node {
 struct NodeContext;
 } // namespace node
@@ -40,9 +44,15 @@ void RPCNotifyBlockChange(const CBlockIndex*);
 /** Block description to JSON */
 UniValue blockToJSON(node::BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity) LOCKS_EXCLUDED(cs_main);
 
+/** Block description to JSON, written one transaction at a time */
+void blockToJSON(node::BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity, common::JSONWriter& writer) LOCKS_EXCLUDED(cs_main);
+
 /** Block header to JSON */
 UniValue blockheaderToJSON(const CBlockIndex& tip, const CBlockIndex& blockindex) LOCKS_EXCLUDED(cs_main);
 
+/** BLSCT outputs of a block, as recorded by the view tag index, to JSON */
+UniValue viewTagEntriesToJSON(const ViewTagEntries& entries, int height);
+
 /** Used by getblockstats to get feerates at different percentiles by weight  */
 void CalculatePercentilesByWeight(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_weight);
 
@@ -8,8 +8,11 @@
 #include <kernel/mempool_persist.h>
 
 #include <chainparams.h>
+#include <common/json_writer.h>
 #include <core_io.h>
 #include <kernel/mempool_entry.h>
+#include <net_processing.h>
+#include <node/context.h>
 #include <node/mempool_persist_args.h>
 #include <policy/rbf.h>
 #include <policy/settings.h>
@@ -24,6 +27,7 @@
 #include <util/strencodings.h>
 #include <util/time.h>
 
+#include <optional>
 #include <utility>
 
 using kernel::DumpMempool;
@@ -373,6 +377,19 @@ UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempoo
     }
 }
 
+void MempoolToJSON(const CTxMemPool& pool, common::JSONWriter& writer)
+{
+    LOCK(pool.cs);
+    writer.BeginObject();
+    for (const CTxMemPoolEntry& e : pool.entryAll()) {
+        UniValue info(UniValue::VOBJ);
+        entryToJSON(pool, info, e);
+        writer.Key(e.GetTx().GetHash().ToString());
+        writer.Value(info);
+    }
+    writer.EndObject();
+}
+
 static RPCHelpMan getrawmempool()
 {
     return RPCHelpMan{"getrawmempool",
@@ -578,6 +595,7 @@ static RPCHelpMan getmempoolentry()
     entryToJSON(mempool, info, *entry);
     return info;
 },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -663,8 +681,9 @@ static RPCHelpMan gettxspendingprevout()
     };
 }
 
-UniValue MempoolInfoToJSON(const CTxMemPool& pool)
+UniValue MempoolInfoToJSON(const CTxMemPool& pool, PeerManager* peerman)
 {
+    const std::optional<StempoolStats> stempool{peerman ? std::make_optional(peerman->GetStempoolStats()) : std::nullopt};
     // Make sure this call is atomic in the pool.
     LOCK(pool.cs);
     UniValue ret(UniValue::VOBJ);
@@ -679,6 +698,10 @@ UniValue MempoolInfoToJSON(const CTxMemPool& pool)
     ret.pushKV("incrementalrelayfee", ValueFromAmount(pool.m_incremental_relay_feerate.GetFeePerK()));
     ret.pushKV("unbroadcastcount", uint64_t{pool.GetUnbroadcastTxs().size()});
     ret.pushKV("fullrbf", pool.m_full_rbf);
+    if (stempool) {
+        ret.pushKV("stempoolsize", uint64_t{stempool->m_count});
+        ret.pushKV("stempoolbytes", stempool->m_vsize);
+    }
     return ret;
 }
 
@@ -701,6 +724,8 @@ static RPCHelpMan getmempoolinfo()
                 {RPCResult::Type::NUM, "incrementalrelayfee", "minimum fee rate increment for mempool limiting or replacement in " + CURRENCY_UNIT + "/kvB"},
                 {RPCResult::Type::NUM, "unbroadcastcount", "Current number of transactions that haven't passed initial broadcast yet"},
                 {RPCResult::Type::BOOL, "fullrbf", "True if the mempool accepts RBF without replaceability signaling inspection"},
+                {RPCResult::Type::NUM, "stempoolsize", /*optional=*/true, "Current number of transactions in Dandelion++ stem phase"},
+                {RPCResult::Type::NUM, "stempoolbytes", /*optional=*/true, "Sum of the virtual sizes of the transactions in Dandelion++ stem phase"},
             }},
         RPCExamples{
             HelpExampleCli("getmempoolinfo", "")
@@ -708,7 +733,8 @@ static RPCHelpMan getmempoolinfo()
         },
         [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {
-    return MempoolInfoToJSON(EnsureAnyMemPool(request.context));
+    const NodeContext& node{EnsureAnyNodeContext(request.context)};
+    return MempoolInfoToJSON(EnsureMemPool(node), node.peerman.get());
 },
     };
 }
@@ -6,12 +6,19 @@
 #define BITCOIN_RPC_MEMPOOL_H
 
 class CTxMemPool;
+class PeerManager;
 class UniValue;
+namespace common {
+class JSONWriter;
+} // namespace common
 
-/** Mempool information to JSON */
-UniValue MempoolInfoToJSON(const CTxMemPool& pool);
+/** Mempool information to JSON, with the Dandelion++ stempool depth if peerman is given */
+UniValue MempoolInfoToJSON(const CTxMemPool& pool, PeerManager* peerman = nullptr);
 
 /** Mempool to JSON */
 UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose = false, bool include_mempool_sequence = false);
 
+/** Verbose mempool to JSON, written one entry at a time */
+void MempoolToJSON(const CTxMemPool& pool, common::JSONWriter& writer);
+
 #endif // BITCOIN_RPC_MEMPOOL_H
@@ -1091,6 +1091,11 @@ static RPCHelpMan submitblock()
         throw JSONRPCError(RPC_DESERIALIZATION_ERROR, "Block does not start with a coinbase");
     }
 
+    if (block.vtx.size() == 2 && block.vtx[0]->IsBLSCT()) {
+        // Blocks built from our own template can be relayed as compact blocks
+        block.vBLSCTComponents = BlockAssembler::GetBLSCTComponents(*block.vtx[1]);
+    }
+
     ChainstateManager& chainman = EnsureAnyChainman(request.context);
     uint256 hash = block.GetHash();
     {
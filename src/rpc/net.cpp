@@ -168,6 +168,9 @@ static RPCHelpMan getpeerinfo()
                         {RPCResult::Type::STR, "permission_type", Join(NET_PERMISSIONS_DOC, ",\n") + ".\n"},
                     }},
                     {RPCResult::Type::NUM, "minfeefilter", "The minimum fee rate for transactions this peer accepts"},
+                    {RPCResult::Type::BOOL, "stem_route", "Whether this peer is one of our Dandelion++ stem routes"},
+                    {RPCResult::Type::NUM, "stem_txs_sent", "The total number of stem transactions announced to this peer"},
+                    {RPCResult::Type::NUM, "stem_latency", /*optional=*/true, "The average time in seconds stem transactions waited to be announced to this peer, if any were"},
                     {RPCResult::Type::OBJ_DYN, "bytessent_per_msg", "",
                     {
                         {RPCResult::Type::NUM, "msg", "The total bytes sent aggregated by message type\n"
@@ -275,6 +278,11 @@ static RPCHelpMan getpeerinfo()
         }
         obj.pushKV("permissions", permissions);
         obj.pushKV("minfeefilter", ValueFromAmount(statestats.m_fee_filter_received));
+        obj.pushKV("stem_route", statestats.m_stem_route);
+        obj.pushKV("stem_txs_sent", statestats.m_stem_txs_sent);
+        if (statestats.m_stem_txs_sent > 0) {
+            obj.pushKV("stem_latency", Ticks<SecondsDouble>(statestats.m_stem_latency));
+        }
 
         UniValue sendPerMsgType(UniValue::VOBJ);
         for (const auto& i : stats.mapSendBytesPerMsgType) {
@@ -446,6 +446,7 @@ static RPCHelpMan getrawtransaction()
     TxToJSON(*tx, hash_block, result, chainman.ActiveChainstate(), undoTX, TxVerbosity::SHOW_DETAILS_AND_PREVOUT);
     return result;
 },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -512,6 +513,7 @@ static RPCHelpMan decoderawtransaction()
 
             return result;
         },
+        RPCMethodOptions{.parallel_batch = true},
     };
 }
 
@@ -11,6 +11,10 @@
 
 #include <univalue.h>
 
+namespace common {
+class JSONWriter;
+} // namespace common
+
 UniValue JSONRPCRequestObj(const std::string& strMethod, const UniValue& params, const UniValue& id);
 UniValue JSONRPCReplyObj(const UniValue& result, const UniValue& error, const UniValue& id);
 std::string JSONRPCReply(const UniValue& result, const UniValue& error, const UniValue& id);
@@ -36,6 +40,12 @@ public:
     std::string authUser;
     std::string peerAddr;
     std::any context;
+    /**
+     * Where the reply expects the result value, if the server can take it
+     * piece by piece. A method with a large result may write it here instead
+     * of returning it, and then returns a null UniValue.
+     */
+    common::JSONWriter* result_writer{nullptr};
 
     void parse(const UniValue& valRequest);
 };
@@ -7,6 +7,7 @@
 
 #include <common/args.h>
 #include <common/system.h>
+#include <httpserver.h>
 #include <logging.h>
 #include <node/context.h>
 #include <rpc/server_util.h>
@@ -15,18 +16,27 @@
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/string.h>
+#include <util/threadnames.h>
 #include <util/time.h>
 
 #include <boost/signals2/signal.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <system_error>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 static GlobalMutex g_rpc_warmup_mutex;
 static std::atomic<bool> g_rpc_running{false};
+//! Threads that batched calls can still be run on, see -rpcbatchthreads
+static std::atomic<int> g_rpc_batch_threads{0};
 static bool fRPCInWarmup GUARDED_BY(g_rpc_warmup_mutex) = true;
 static std::string rpcWarmupStatus GUARDED_BY(g_rpc_warmup_mutex) = "RPC server started";
 /* Timer-creating functions */
@@ -226,6 +236,21 @@ static RPCHelpMan getrpcinfo()
                             }},
                         }},
                         {RPCResult::Type::STR, "logpath", "The complete file path to the debug log"},
+                        {RPCResult::Type::OBJ, "work_queue", /*optional=*/true, "Requests waiting for a worker thread, omitted if the HTTP server is not running",
+                        {
+                            {RPCResult::Type::NUM, "depth", "The number of requests waiting"},
+                            {RPCResult::Type::NUM, "max_depth", "The maximum number of requests waiting (-rpcworkqueue)"},
+                            {RPCResult::Type::NUM, "rejected", "The number of requests rejected because the queue was full"},
+                            {RPCResult::Type::NUM, "stolen", "The number of requests taken over from the queue of another worker"},
+                            {RPCResult::Type::ARR, "wait_histogram", "How long requests have waited for a worker",
+                            {
+                                {RPCResult::Type::OBJ, "", "",
+                                {
+                                    {RPCResult::Type::NUM, "max_us", /*optional=*/true, "The upper bound of the bucket in microseconds, omitted for the last bucket"},
+                                    {RPCResult::Type::NUM, "count", "The number of requests in the bucket"},
+                                }},
+                            }},
+                        }},
                     }
                 },
                 RPCExamples{
@@ -249,6 +274,25 @@ static RPCHelpMan getrpcinfo()
     UniValue log_path(UniValue::VSTR, path);
     result.pushKV("logpath", log_path);
 
+    if (const auto stats{GetHTTPWorkQueueStats()}) {
+        UniValue work_queue(UniValue::VOBJ);
+        work_queue.pushKV("depth", uint64_t{stats->depth});
+        work_queue.pushKV("max_depth", uint64_t{stats->max_depth});
+        work_queue.pushKV("rejected", stats->rejected);
+        work_queue.pushKV("stolen", stats->stolen);
+        UniValue histogram(UniValue::VARR);
+        for (size_t i = 0; i < stats->wait_counts.size(); ++i) {
+            UniValue bucket(UniValue::VOBJ);
+            if (i < HTTP_QUEUE_WAIT_BUCKETS.size()) {
+                bucket.pushKV("max_us", int64_t{Ticks<std::chrono::microseconds>(HTTP_QUEUE_WAIT_BUCKETS[i])});
+            }
+            bucket.pushKV("count", stats->wait_counts[i]);
+            histogram.push_back(bucket);
+        }
+        work_queue.pushKV("wait_histogram", histogram);
+        result.pushKV("work_queue", work_queue);
+    }
+
     return result;
 }
     };
@@ -292,6 +336,7 @@ bool CRPCTable::removeCommand(const std::string& name, const CRPCCommand* pcmd)
 void StartRPC()
 {
     LogPrint(BCLog::RPC, "Starting RPC\n");
+    g_rpc_batch_threads = std::max<int>(gArgs.GetIntArg("-rpcbatchthreads", DEFAULT_RPC_BATCH_THREADS), 0);
     g_rpc_running = true;
     g_rpcSignals.Started();
 }
@@ -381,12 +426,74 @@ static UniValue JSONRPCExecOne(JSONRPCRequest jreq, const UniValue& req)
     return rpc_result;
 }
 
+/**
+ * Run the calls of a batch in [begin, end), which may all run at the same
+ * time, on this thread and as many batch threads as are free.
+ */
+static void JSONRPCExecParallel(const JSONRPCRequest& jreq, const UniValue& vReq, size_t begin, size_t end, std::vector<UniValue>& results)
+{
+    std::atomic<size_t> next{begin};
+    const auto run_calls{[&] {
+        for (size_t reqIdx; (reqIdx = next++) < end;) {
+            results[reqIdx] = JSONRPCExecOne(jreq, vReq[reqIdx]);
+        }
+    }};
+
+    // Take as many of the free batch threads as there are calls for, leaving
+    // one call for this thread.
+    const int wanted = static_cast<int>(std::min<size_t>(end - begin - 1, std::numeric_limits<int>::max()));
+    int free_threads = g_rpc_batch_threads.load();
+    int helpers;
+    do {
+        helpers = std::min(wanted, std::max(free_threads, 0));
+    } while (!g_rpc_batch_threads.compare_exchange_weak(free_threads, free_threads - helpers));
+
+    std::vector<std::thread> threads;
+    threads.reserve(helpers);
+    for (int i = 0; i < helpers; ++i) {
+        try {
+            threads.emplace_back([&] {
+                util::ThreadRename("rpcbatch");
+                run_calls();
+            });
+        } catch (const std::system_error& e) {
+            LogPrintf("%s: unable to start batch thread: %s\n", __func__, e.what());
+            break;
+        }
+    }
+    run_calls();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    g_rpc_batch_threads += helpers;
+}
+
 std::string JSONRPCExecBatch(const JSONRPCRequest& jreq, const UniValue& vReq)
 {
-    UniValue ret(UniValue::VARR);
-    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
-        ret.push_back(JSONRPCExecOne(jreq, vReq[reqIdx]));
+    // Runs of calls that do not change any state run at the same time. Any
+    // other call waits for the calls before it and holds up those after it,
+    // so the batch behaves as if it ran in order.
+    std::vector<UniValue> results(vReq.size());
+    for (size_t reqIdx = 0; reqIdx < vReq.size();) {
+        size_t run_end = reqIdx;
+        while (run_end < vReq.size() && vReq[run_end].isObject()) {
+            const UniValue& method = vReq[run_end].find_value("method");
+            if (!method.isStr() || !tableRPC.IsParallelBatchSafe(method.get_str())) break;
+            ++run_end;
+        }
+        if (run_end - reqIdx > 1) {
+            JSONRPCExecParallel(jreq, vReq, reqIdx, run_end, results);
+            reqIdx = run_end;
+        } else {
+            results[reqIdx] = JSONRPCExecOne(jreq, vReq[reqIdx]);
+            ++reqIdx;
+        }
+    }
 
+    UniValue ret(UniValue::VARR);
+    for (UniValue& result : results) {
+        ret.push_back(std::move(result));
+    }
     return ret.write() + "\n";
 }
 
@@ -528,6 +635,13 @@ UniValue CRPCTable::execute(const JSONRPCRequest &request) const
     throw JSONRPCError(RPC_METHOD_NOT_FOUND, "Method not found");
 }
 
+bool CRPCTable::IsParallelBatchSafe(const std::string& method) const
+{
+    auto it = mapCommands.find(method);
+    if (it == mapCommands.end()) return false;
+    return std::all_of(it->second.begin(), it->second.end(), [](const CRPCCommand* command) { return command->parallel_batch; });
+}
+
 static bool ExecuteCommand(const CRPCCommand& command, const JSONRPCRequest& request, UniValue& result, bool last_handler)
 {
     try {
@@ -16,6 +16,9 @@
 
 #include <univalue.h>
 
+/** Default number of threads, shared by all batches, that batched calls can run on next to the thread handling the batch */
+static constexpr int DEFAULT_RPC_BATCH_THREADS{4};
+
 class CRPCCommand;
 
 namespace RPCServer
@@ -108,6 +111,7 @@ public:
               fn().GetArgNames(),
               intptr_t(fn))
     {
+        parallel_batch = fn().m_opts.parallel_batch;
     }
 
     std::string category;
@@ -124,6 +128,8 @@ public:
     //! appended after other arguments, see transformNamedArguments for details.
     std::vector<std::pair<std::string, bool>> argNames;
     intptr_t unique_id;
+    //! Whether calls within a batch may run at the same time, see RPCMethodOptions
+    bool parallel_batch{false};
 };
 
 /**
@@ -145,6 +151,12 @@ public:
      */
     UniValue execute(const JSONRPCRequest &request) const;
 
+    /**
+     * Whether calls of a method within a batch may run at the same time as
+     * other such calls, see RPCMethodOptions.
+     */
+    bool IsParallelBatchSafe(const std::string& method) const;
+
     /**
     * Returns a list of registered commands
     * @returns List of registered commands.
@@ -5,6 +5,7 @@
 #include <clientversion.h>
 #include <core_io.h>
 #include <common/args.h>
+#include <common/json_writer.h>
 #include <consensus/amount.h>
 #include <script/interpreter.h>
 #include <key_io.h>
@@ -515,8 +516,9 @@ struct Sections {
 RPCHelpMan::RPCHelpMan(std::string name, std::string description, std::vector<RPCArg> args, RPCResults results, RPCExamples examples)
     : RPCHelpMan{std::move(name), std::move(description), std::move(args), std::move(results), std::move(examples), nullptr} {}
 
-RPCHelpMan::RPCHelpMan(std::string name, std::string description, std::vector<RPCArg> args, RPCResults results, RPCExamples examples, RPCMethodImpl fun)
+RPCHelpMan::RPCHelpMan(std::string name, std::string description, std::vector<RPCArg> args, RPCResults results, RPCExamples examples, RPCMethodImpl fun, RPCMethodOptions opts)
     : m_name{std::move(name)},
+      m_opts{std::move(opts)},
       m_fun{std::move(fun)},
       m_description{std::move(description)},
       m_args{std::move(args)},
@@ -629,7 +631,9 @@ UniValue RPCHelpMan::HandleRequest(const JSONRPCRequest& request) const
     m_req = &request;
     UniValue ret = m_fun(*this, request);
     m_req = nullptr;
-    if (gArgs.GetBoolArg("-rpcdoccheck", DEFAULT_RPC_DOC_CHECK)) {
+    // A result written to request.result_writer has already been sent.
+    const bool result_written{request.result_writer && !request.result_writer->AfterKey()};
+    if (!result_written && gArgs.GetBoolArg("-rpcdoccheck", DEFAULT_RPC_DOC_CHECK)) {
         UniValue mismatch{UniValue::VARR};
         for (const auto& res : m_results.m_results) {
             UniValue match{res.MatchesType(ret)};
@@ -389,12 +389,17 @@ struct RPCExamples {
     std::string ToDescriptionString() const;
 };
 
+struct RPCMethodOptions {
+    bool parallel_batch{false}; //!< Calls within a JSON-RPC batch may run at the same time as other such calls. Only for
+                                //!< methods that do not change any state and are safe to run on several threads at once.
+};
+
 class RPCHelpMan
 {
 public:
     RPCHelpMan(std::string name, std::string description, std::vector<RPCArg> args, RPCResults results, RPCExamples examples);
     using RPCMethodImpl = std::function<UniValue(const RPCHelpMan&, const JSONRPCRequest&)>;
-    RPCHelpMan(std::string name, std::string description, std::vector<RPCArg> args, RPCResults results, RPCExamples examples, RPCMethodImpl fun);
+    RPCHelpMan(std::string name, std::string description, std::vector<RPCArg> args, RPCResults results, RPCExamples examples, RPCMethodImpl fun, RPCMethodOptions opts = {});
 
     UniValue HandleRequest(const JSONRPCRequest& request) const;
     /**
@@ -444,6 +449,7 @@ public:
     std::vector<std::pair<std::string, bool>> GetArgNames() const;
 
     const std::string m_name;
+    const RPCMethodOptions m_opts;
 
 private:
     const RPCMethodImpl m_fun;
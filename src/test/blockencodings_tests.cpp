@@ -3,8 +3,10 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <blockencodings.h>
+#include <blsct/wallet/txfactory_global.h>
 #include <chainparams.h>
 #include <consensus/merkle.h>
+#include <consensus/validation.h>
 #include <pow.h>
 #include <streams.h>
 #include <test/util/random.h>
@@ -75,7 +77,7 @@ BOOST_AUTO_TEST_CASE(SimpleRoundTripTest)
         stream >> shortIDs2;
 
         PartiallyDownloadedBlock partialBlock(&pool);
-        BOOST_CHECK(partialBlock.InitData(shortIDs2, extra_txn) == READ_STATUS_OK);
+        BOOST_CHECK(partialBlock.InitData(shortIDs2, extra_txn, /*blsct_components=*/true) == READ_STATUS_OK);
         BOOST_CHECK( partialBlock.IsTxAvailable(0));
         BOOST_CHECK(!partialBlock.IsTxAvailable(1));
         BOOST_CHECK( partialBlock.IsTxAvailable(2));
@@ -302,6 +304,118 @@ BOOST_AUTO_TEST_CASE(EmptyBlockRoundTripTest)
     }
 }
 
+BOOST_AUTO_TEST_CASE(BLSCTAggregatedRoundTripTest)
+{
+    CTxMemPool& pool = *Assert(m_node.mempool);
+    TestMemPoolEntryHelper entry;
+
+    CMutableTransaction coinbase;
+    coinbase.nVersion = CTransaction::BLSCT_MARKER;
+    coinbase.vin.resize(1);
+    coinbase.vin[0].scriptSig.resize(10);
+    coinbase.vout.resize(1);
+    coinbase.vout[0].nValue = 42;
+
+    std::vector<CTransactionRef> components;
+    for (size_t i = 0; i < 3; i++) {
+        CMutableTransaction tx;
+        tx.nVersion = CTransaction::BLSCT_MARKER;
+        tx.vin.resize(1);
+        tx.vin[0].prevout.hash = Txid::FromUint256(InsecureRand256());
+        tx.vin[0].prevout.n = 0;
+        tx.vout.resize(2);
+        tx.vout[0].nValue = 42;
+        tx.vout[1].nValue = 1;
+        tx.vout[1].scriptPubKey = CScript{OP_RETURN};
+        components.push_back(MakeTransactionRef(tx));
+    }
+
+    CBlock block;
+    block.vtx.push_back(MakeTransactionRef(std::move(coinbase)));
+    block.vtx.push_back(blsct::AggregateTransactions(components, /*fCutThrough=*/true));
+    block.vBLSCTComponents = components;
+    block.nVersion = 42;
+    block.hashPrevBlock = InsecureRand256();
+    block.nBits = 0x207fffff;
+
+    bool mutated;
+    block.hashMerkleRoot = BlockMerkleRoot(block, &mutated);
+    assert(!mutated);
+    while (!CheckProofOfWork(block.GetHash(), block.nBits, Params().GetConsensus())) ++block.nNonce;
+
+    auto check_merkle_root = [](const CBlock& block, BlockValidationState& state, const Consensus::Params&, bool, bool) {
+        bool mutated;
+        if (block.hashMerkleRoot != BlockMerkleRoot(block, &mutated)) {
+            return state.Invalid(BlockValidationResult::BLOCK_MUTATED, "bad-txnmrklroot");
+        }
+        return true;
+    };
+
+    CBlockHeaderAndShortTxIDs shortIDs{block, /*blsct_components=*/true};
+    BOOST_CHECK_EQUAL(shortIDs.BlockTxCount(), components.size() + 1);
+
+    DataStream stream{};
+    stream << shortIDs;
+
+    CBlockHeaderAndShortTxIDs shortIDs2;
+    stream >> shortIDs2;
+
+    LOCK2(cs_main, pool.cs);
+
+    // Without the negotiated encoding the aggregated transaction is sent as is
+    {
+        CBlockHeaderAndShortTxIDs legacyIDs{block};
+        BOOST_CHECK_EQUAL(legacyIDs.BlockTxCount(), block.vtx.size());
+
+        PartiallyDownloadedBlock partialBlock(&pool);
+        partialBlock.m_check_block_mock = check_merkle_root;
+        BOOST_CHECK(partialBlock.InitData(legacyIDs, extra_txn) == READ_STATUS_OK);
+        BOOST_CHECK( partialBlock.IsTxAvailable(0));
+        BOOST_CHECK(!partialBlock.IsTxAvailable(1));
+
+        CBlock block2;
+        BOOST_CHECK(partialBlock.FillBlock(block2, {block.vtx[1]}) == READ_STATUS_OK);
+        BOOST_CHECK_EQUAL(block.GetHash().ToString(), block2.GetHash().ToString());
+        BOOST_CHECK(block2.vBLSCTComponents.empty());
+    }
+
+    pool.addUnchecked(entry.FromTx(components[0]));
+    pool.addUnchecked(entry.FromTx(components[1]));
+
+    // Only the aggregated transaction is requested when a component is missing
+    {
+        PartiallyDownloadedBlock partialBlock(&pool);
+        partialBlock.m_check_block_mock = check_merkle_root;
+        BOOST_CHECK(partialBlock.InitData(shortIDs2, extra_txn, /*blsct_components=*/true) == READ_STATUS_OK);
+        BOOST_CHECK( partialBlock.IsTxAvailable(0));
+        BOOST_CHECK(!partialBlock.IsTxAvailable(1));
+        BOOST_CHECK( partialBlock.IsTxAvailable(2));
+        BOOST_CHECK( partialBlock.IsTxAvailable(3));
+
+        CBlock block2;
+        BOOST_CHECK(partialBlock.FillBlock(block2, {block.vtx[1]}) == READ_STATUS_OK);
+        BOOST_CHECK_EQUAL(block.GetHash().ToString(), block2.GetHash().ToString());
+        BOOST_CHECK(block2.vBLSCTComponents.empty());
+    }
+
+    // The aggregated transaction is rebuilt from the mempool
+    pool.addUnchecked(entry.FromTx(components[2]));
+    {
+        PartiallyDownloadedBlock partialBlock(&pool);
+        partialBlock.m_check_block_mock = check_merkle_root;
+        BOOST_CHECK(partialBlock.InitData(shortIDs2, extra_txn, /*blsct_components=*/true) == READ_STATUS_OK);
+        for (size_t i = 0; i < shortIDs2.BlockTxCount(); i++) {
+            BOOST_CHECK(partialBlock.IsTxAvailable(i));
+        }
+
+        CBlock block2;
+        BOOST_CHECK(partialBlock.FillBlock(block2, {}) == READ_STATUS_OK);
+        BOOST_CHECK_EQUAL(block.GetHash().ToString(), block2.GetHash().ToString());
+        BOOST_CHECK_EQUAL(block.hashMerkleRoot.ToString(), BlockMerkleRoot(block2, &mutated).ToString());
+        BOOST_CHECK(block2.vBLSCTComponents == components);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(TransactionsRequestSerializationTest) {
     BlockTransactionsRequest req1;
     req1.blockhash = InsecureRand256();
@@ -127,6 +127,44 @@ BOOST_FIXTURE_TEST_CASE(blockfilter_basic_test, BasicTestingSetup)
     BOOST_CHECK(default_ctor_block_filter_1.GetEncodedFilter() == default_ctor_block_filter_2.GetEncodedFilter());
 }
 
+BOOST_FIXTURE_TEST_CASE(blockfilter_blsct_test, BasicTestingSetup)
+{
+    MclG1Point spent_commitment = MclG1Point::Rand();
+
+    CTxOut blsct_out;
+    blsct_out.nValue = 0;
+    blsct_out.blsctData.rangeProof.Vs.Add(MclG1Point::Rand());
+    blsct_out.blsctData.blindingKey = MclG1Point::Rand();
+    blsct_out.blsctData.viewTag = 0x1234;
+
+    CMutableTransaction tx;
+    tx.vout.push_back(blsct_out);
+    tx.vout.emplace_back(100, CScript() << OP_TRUE);
+
+    CBlock block;
+    block.vtx.push_back(MakeTransactionRef(tx));
+
+    CTxOut spent_out;
+    spent_out.nValue = 0;
+    spent_out.blsctData.rangeProof.Vs.Add(spent_commitment);
+
+    CBlockUndo block_undo;
+    block_undo.vtxundo.emplace_back();
+    block_undo.vtxundo.back().vprevout.emplace_back(spent_out, 1, false);
+
+    BlockFilter block_filter(BlockFilterType::BLSCT, block, block_undo);
+    const GCSFilter& filter = block_filter.GetFilter();
+
+    // Only the spent output is in the filter
+    BOOST_CHECK_EQUAL(filter.GetN(), 1U);
+    BOOST_CHECK(filter.Match(BLSCTSpendFilterElement(spent_commitment)));
+    BOOST_CHECK(!filter.Match(BLSCTSpendFilterElement(blsct_out.blsctData.rangeProof.Vs[0])));
+
+    // The basic filter of the same block only covers scripts
+    BlockFilter basic_filter(BlockFilterType::BASIC, block, block_undo);
+    BOOST_CHECK(!basic_filter.GetFilter().Match(BLSCTSpendFilterElement(spent_commitment)));
+}
+
 BOOST_FIXTURE_TEST_CASE(blockfilters_json_test, BasicTestingSetup)
 {
     UniValue json;
@@ -182,6 +220,7 @@ BOOST_FIXTURE_TEST_CASE(blockfilters_json_test, BasicTestingSetup)
 BOOST_AUTO_TEST_CASE(blockfilter_type_names)
 {
     BOOST_CHECK_EQUAL(BlockFilterTypeName(BlockFilterType::BASIC), "basic");
+    BOOST_CHECK_EQUAL(BlockFilterTypeName(BlockFilterType::BLSCT), "blsct");
     BOOST_CHECK_EQUAL(BlockFilterTypeName(static_cast<BlockFilterType>(255)), "");
 
     BlockFilterType filter_type;
@@ -2,12 +2,15 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <blsct/arith/mcl/mcl.h>
 #include <chainparams.h>
 #include <clientversion.h>
+#include <node/blockcache.h>
 #include <node/blockstorage.h>
 #include <node/context.h>
 #include <node/kernel_notifications.h>
 #include <script/solver.h>
+#include <streams.h>
 #include <primitives/block.h>
 #include <util/chaintype.h>
 #include <validation.h>
@@ -17,6 +20,7 @@
 #include <test/util/setup_common.h>
 
 using node::BLOCK_SERIALIZATION_HEADER_SIZE;
+using node::BlockCache;
 using node::BlockManager;
 using node::KernelNotifications;
 using node::MAX_BLOCKFILE_SIZE;
@@ -201,4 +205,125 @@ BOOST_AUTO_TEST_CASE(blockmanager_flush_block_file)
     BOOST_CHECK_EQUAL(read_block.nVersion, 2);
 }
 
+BOOST_AUTO_TEST_CASE(block_cache_lru)
+{
+    std::vector<std::shared_ptr<const CBlock>> blocks;
+    for (int i = 1; i <= 3; ++i) {
+        auto block{std::make_shared<CBlock>()};
+        block->nVersion = i;
+        blocks.push_back(block);
+    }
+    const auto hash{[&](int i) { return blocks[i]->GetHash(); }};
+
+    // All blocks are empty, so each takes the same space in the cache.
+    size_t block_usage;
+    {
+        BlockCache cache{std::numeric_limits<size_t>::max()};
+        cache.Insert(hash(0), {.block = blocks[0], .raw = nullptr});
+        block_usage = cache.GetStats().usage;
+        BOOST_CHECK_GT(block_usage, 0U);
+    }
+
+    BlockCache cache{2 * block_usage};
+    BOOST_CHECK(!cache.Get(hash(0), /*raw=*/false).block);
+    cache.Insert(hash(0), {.block = blocks[0], .raw = nullptr});
+    cache.Insert(hash(1), {.block = blocks[1], .raw = nullptr});
+    BOOST_CHECK_EQUAL(cache.GetStats().entries, 2U);
+
+    // Looking up the first block makes the second one the least recently used.
+    BOOST_CHECK(cache.Get(hash(0), /*raw=*/false).block == blocks[0]);
+    cache.Insert(hash(2), {.block = blocks[2], .raw = nullptr});
+    BOOST_CHECK(!cache.Get(hash(1), /*raw=*/false).block);
+    BOOST_CHECK(cache.Get(hash(2), /*raw=*/false).block == blocks[2]);
+
+    // A lookup of the form that isn't cached is a miss, but returns the other form.
+    BlockCache::Entry entry{cache.Get(hash(0), /*raw=*/true)};
+    BOOST_CHECK(entry.block == blocks[0]);
+    BOOST_CHECK(!entry.raw);
+
+    // Adding the serialized form keeps the deserialized one, and the larger
+    // entry evicts the least recently used block.
+    auto raw{std::make_shared<std::vector<uint8_t>>()};
+    VectorWriter{*raw, 0, TX_WITH_WITNESS(*blocks[0])};
+    cache.Insert(hash(0), {.block = nullptr, .raw = raw});
+    entry = cache.Get(hash(0), /*raw=*/true);
+    BOOST_CHECK(entry.block == blocks[0]);
+    BOOST_CHECK(entry.raw == raw);
+    BOOST_CHECK(!cache.Get(hash(2), /*raw=*/false).block);
+
+    const BlockCache::Stats stats{cache.GetStats()};
+    BOOST_CHECK_EQUAL(stats.entries, 1U);
+    BOOST_CHECK_LE(stats.usage, stats.max_usage);
+    BOOST_CHECK_EQUAL(stats.block_hits, 2U);
+    BOOST_CHECK_EQUAL(stats.block_misses, 3U);
+    BOOST_CHECK_EQUAL(stats.raw_hits, 1U);
+    BOOST_CHECK_EQUAL(stats.raw_misses, 1U);
+
+    // A disabled cache doesn't keep anything.
+    BlockCache disabled{0};
+    disabled.Insert(hash(0), {.block = blocks[0], .raw = raw});
+    BOOST_CHECK_EQUAL(disabled.GetStats().entries, 0U);
+    BOOST_CHECK_EQUAL(disabled.GetStats().usage, 0U);
+}
+
+BOOST_FIXTURE_TEST_CASE(blockmanager_read_block_cached, TestChain100Setup)
+{
+    BlockManager& blockman{m_node.chainman->m_blockman};
+    const CBlockIndex& index{*WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain()[50])};
+    const CBlockIndex& other{*WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain()[51])};
+
+    CBlock disk_block;
+    BOOST_REQUIRE(blockman.ReadBlockFromDisk(disk_block, index));
+    std::vector<uint8_t> disk_raw;
+    BOOST_REQUIRE(blockman.ReadRawBlockFromDisk(disk_raw, WITH_LOCK(::cs_main, return index.GetBlockPos())));
+
+    // The first read misses and fills the cache, later reads share the cached block.
+    const auto block{blockman.ReadBlockCached(index)};
+    BOOST_REQUIRE(block);
+    BOOST_CHECK_EQUAL(block->GetHash(), index.GetBlockHash());
+    BOOST_CHECK(blockman.ReadBlockCached(index) == block);
+
+    // The serialized form is derived from the cached block and matches the block file.
+    const auto raw{blockman.ReadRawBlockCached(index)};
+    BOOST_REQUIRE(raw);
+    BOOST_CHECK(*raw == disk_raw);
+    BOOST_CHECK(blockman.ReadRawBlockCached(index) == raw);
+
+    // Reads that don't populate the cache leave it unchanged.
+    BOOST_REQUIRE(blockman.ReadRawBlockCached(other, /*populate=*/false));
+    const auto other_block{blockman.ReadBlockCached(other, /*populate=*/false)};
+    BOOST_REQUIRE(other_block);
+    BOOST_CHECK_EQUAL(other_block->GetHash(), other.GetBlockHash());
+    BOOST_CHECK(blockman.ReadBlockCached(other, /*populate=*/false) != other_block);
+
+    const BlockCache::Stats stats{blockman.GetBlockCacheStats()};
+    BOOST_CHECK_EQUAL(stats.entries, 1U);
+    BOOST_CHECK_EQUAL(stats.block_hits, 1U);
+    BOOST_CHECK_EQUAL(stats.block_misses, 3U);
+    BOOST_CHECK_EQUAL(stats.raw_hits, 1U);
+    BOOST_CHECK_EQUAL(stats.raw_misses, 2U);
+}
+
+BOOST_FIXTURE_TEST_CASE(blockmanager_read_block_cached_from_raw, TestChain100Setup)
+{
+    BlockManager& blockman{m_node.chainman->m_blockman};
+    const CBlockIndex& index{*WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain()[60])};
+
+    // A block deserialized from the cached block file contents passes the
+    // same checks as one read from disk, and points collected by a deferred
+    // scope of the caller are not kept in the cache.
+    BOOST_REQUIRE(blockman.ReadRawBlockCached(index));
+    MclG1Point::DeferredOrderChecks deferred_checks;
+    const auto block{blockman.ReadBlockCached(index)};
+    BOOST_REQUIRE(block);
+    BOOST_CHECK_EQUAL(block->GetHash(), index.GetBlockHash());
+    BOOST_CHECK(block->vDeferredPoints.empty());
+    BOOST_CHECK(deferred_checks.points.empty());
+
+    const BlockCache::Stats stats{blockman.GetBlockCacheStats()};
+    BOOST_CHECK_EQUAL(stats.entries, 1U);
+    BOOST_CHECK_EQUAL(stats.block_misses, 1U);
+    BOOST_CHECK_EQUAL(stats.raw_misses, 1U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -64,4 +64,59 @@ BOOST_AUTO_TEST_CASE(test_map_str_to_point)
 
     // Empty string should not be mapped to a point
     BOOST_CHECK_THROW(Point::MapToPoint(""), std::runtime_error);
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(test_deferred_order_checks)
+{
+    // Look for a compressed encoding of a point on the curve which is not
+    // in the prime order subgroup
+    std::vector<uint8_t> vec(Point::SERIALIZATION_SIZE, 0);
+    vec[0] = 0x80;
+    bool found = false;
+    for (uint8_t x = 1; x < 255 && !found; ++x) {
+        vec.back() = x;
+        Point::DeferredOrderChecks deferred_checks;
+        Point p;
+        found = p.SetVch(vec);
+        if (found) {
+            BOOST_CHECK_EQUAL(deferred_checks.points.size(), 1);
+            BOOST_CHECK(!deferred_checks.points[0].IsValidOrder());
+            BOOST_CHECK(!p.IsValid());
+        }
+    }
+    BOOST_REQUIRE(found);
+
+    // The same encoding is rejected when the check is not deferred
+    Point q;
+    BOOST_CHECK(!q.SetVch(vec));
+    BOOST_CHECK(q.IsZero());
+
+    // Points in the subgroup pass the deferred check
+    DataStream st{};
+    st << Point::Rand() << Point::Rand();
+    {
+        Point::DeferredOrderChecks deferred_checks;
+        Point a, b;
+        st >> a >> b;
+        BOOST_CHECK_EQUAL(deferred_checks.points.size(), 2);
+        BOOST_CHECK(deferred_checks.points[0] == a);
+        BOOST_CHECK(deferred_checks.points[1] == b);
+        BOOST_CHECK(a.IsValidOrder() && b.IsValidOrder());
+    }
+    BOOST_CHECK(Point::DeferredOrderChecks::Current() == nullptr);
+
+    // Without a deferring scope, deserializing the encoding fails...
+    DataStream bad{};
+    bad.write(MakeByteSpan(vec));
+    Point r;
+    BOOST_CHECK_THROW(bad >> r, std::ios_base::failure);
+
+    // ...and a scope which doesn't collect skips the check
+    bad.clear();
+    bad.write(MakeByteSpan(vec));
+    {
+        Point::DeferredOrderChecks skip_checks{/*collect=*/false};
+        bad >> r;
+        BOOST_CHECK(skip_checks.points.empty());
+        BOOST_CHECK(!r.IsValidOrder());
+    }
+}
@@ -8,8 +8,10 @@
 #include <consensus/amount.h>
 #include <consensus/consensus.h>
 #include <core_io.h>
+#include <node/miner.h>
 #include <policy/fees.h>
 #include <test/util/random.h>
+#include <util/time.h>
 #include <validation.h>
 #include <wallet/coincontrol.h>
 #include <wallet/receive.h>
@@ -105,7 +107,10 @@ BOOST_FIXTURE_TEST_CASE(StakedCommitment, TestBLSCTChain100Setup)
         while (!fStop) {
             block.posProof = blsct::ProofOfStakeLogic::Create(coins_view_cache, out3.value, out3.gamma, index, block, m_node.chainman->GetConsensus());
 
-            if (blsct::ProofOfStakeLogic::Verify(coins_view_cache, index, block, m_node.chainman->GetConsensus()))
+            bool eligible = blsct::ProofOfStakeLogic::IsKernelEligible(out3.value, out3.gamma, index, block, m_node.chainman->GetConsensus());
+            BOOST_CHECK_EQUAL(eligible, blsct::ProofOfStakeLogic::Verify(coins_view_cache, index, block, m_node.chainman->GetConsensus()));
+
+            if (eligible)
                 fStop = true;
             else
                 block.nTime += 1;
@@ -119,5 +124,111 @@ BOOST_FIXTURE_TEST_CASE(StakedCommitment, TestBLSCTChain100Setup)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(LastStakeModifier, TestBLSCTChain100Setup)
+{
+    LOCK(cs_main);
+    bool generated{false};
+
+    for (const CBlockIndex* pindex = m_node.chainman->ActiveChain().Tip(); pindex; pindex = pindex->pprev) {
+        // the last block which generated a modifier, found by walking back
+        const CBlockIndex* pwalk = pindex;
+        while (pwalk->pprev && !pwalk->GeneratedStakeModifier())
+            pwalk = pwalk->pprev;
+
+        uint64_t nStakeModifier;
+        int64_t nModifierTime;
+        BOOST_CHECK(blsct::GetLastStakeModifier(pindex, nStakeModifier, nModifierTime));
+        BOOST_CHECK_EQUAL(nModifierTime, pwalk->GetBlockTime());
+        BOOST_CHECK_EQUAL(nStakeModifier, pwalk->GeneratedStakeModifier() ? pwalk->nStakeModifier : 1);
+
+        generated |= pindex->GeneratedStakeModifier();
+    }
+
+    BOOST_CHECK(generated);
+}
+
+BOOST_FIXTURE_TEST_CASE(StakeBlock, TestBLSCTChain100Setup)
+{
+    CWallet wallet(m_node.chain.get(), "", CreateMockableWalletDatabase());
+    wallet.InitWalletFlags(wallet::WALLET_FLAG_BLSCT);
+
+    blsct::SubAddress destination;
+    blsct::DoublePublicKey recvAddress;
+    {
+        LOCK(wallet.cs_wallet);
+        auto blsct_km = wallet.GetOrCreateBLSCTKeyMan();
+        BOOST_CHECK(blsct_km->SetupGeneration(true));
+        recvAddress = std::get<blsct::DoublePublicKey>(blsct_km->GetNewDestination(0).value());
+        destination = blsct_km->GetSubAddress();
+    }
+
+    // Put two staked commitments in the UTXO set, of which we stake with one
+    auto out = blsct::CreateOutput(recvAddress, 1000 * COIN, "test", TokenId(), Scalar::Rand(), blsct::CreateTransactionType::STAKED_COMMITMENT, 1000 * COIN);
+    {
+        LOCK(cs_main);
+        CCoinsViewCache& coins_tip = m_node.chainman->ActiveChainstate().CoinsTip();
+        Coin coin;
+        coin.nHeight = 1;
+        coin.out = out.out;
+        coins_tip.AddCoin(COutPoint{Txid::FromUint256(InsecureRand256()), 0}, std::move(coin), false);
+        coins_tip.AddCoin(COutPoint{Txid::FromUint256(InsecureRand256()), 0}, CreateCoin(recvAddress), false);
+    }
+
+    const CBlockIndex* prev{WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip())};
+
+    // Move the clock on until the kernel of the commitment meets the target
+    std::optional<uint256> hash;
+    for (int64_t time{std::max<int64_t>(prev->GetBlockTime() + 1, GetTime())}; !hash && time < prev->GetBlockTime() + 10000; ++time) {
+        SetMockTime(time);
+        hash = node::StakeBLSCTBlock(*m_node.chainman, m_node.mempool.get(), {{out.value, out.gamma}}, destination);
+    }
+    BOOST_REQUIRE(hash);
+
+    LOCK(cs_main);
+    const CBlockIndex* tip{m_node.chainman->ActiveChain().Tip()};
+    BOOST_CHECK_EQUAL(tip->GetBlockHash(), *hash);
+    BOOST_CHECK_EQUAL(tip->pprev, prev);
+    BOOST_CHECK(tip->IsProofOfStake());
+}
+
+BOOST_FIXTURE_TEST_CASE(KernelEligibility, BasicTestingSetup)
+{
+    range_proof::GeneratorsFactory<Mcl> gf;
+    range_proof::Generators<Arith> gen = gf.GetInstance(TokenId());
+
+    Scalar m(1000 * COIN);
+    Scalar f = Scalar::Rand();
+
+    Points staked_commitments;
+    staked_commitments.Add(gen.G * m + gen.H * f);
+    staked_commitments.Add(Point::Rand());
+
+    Scalar eta_fiat_shamir = Scalar::Rand();
+    blsct::Message eta_phi{1, 2, 3};
+    uint32_t prev_time = 1000;
+    uint64_t modifier = 42;
+    // roughly half of the kernels need less than m
+    unsigned int next_target = arith_uint256((~arith_uint256()) / arith_uint256(2000 * COIN)).GetCompact();
+
+    int eligible{0};
+    int ineligible{0};
+
+    for (uint32_t time = prev_time + 1; time <= prev_time + 16; ++time) {
+        blsct::ProofOfStake proof(staked_commitments, eta_fiat_shamir, eta_phi, m, f, prev_time, modifier, time, next_target);
+
+        auto phi = blsct::ProofOfStake::CalculatePhi(eta_phi, m, f);
+        BOOST_CHECK(phi == proof.setMemProof.phi);
+
+        auto kernel_hash = blsct::CalculateKernelHash(prev_time, modifier, phi, time);
+        bool is_eligible = blsct::ProofOfStake::IsKernelEligible(m, kernel_hash, next_target);
+        BOOST_CHECK_EQUAL(is_eligible, proof.Verify(staked_commitments, eta_fiat_shamir, eta_phi, kernel_hash, next_target) == blsct::ProofOfStake::VALID);
+
+        is_eligible ? ++eligible : ++ineligible;
+    }
+
+    BOOST_CHECK(eligible > 0);
+    BOOST_CHECK(ineligible > 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace wallet
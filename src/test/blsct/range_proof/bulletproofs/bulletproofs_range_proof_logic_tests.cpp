@@ -99,6 +99,38 @@ BOOST_AUTO_TEST_CASE(test_range_proof_recovery_one_value)
     BOOST_CHECK(xs[0].message == msg.first);
 }
 
+BOOST_AUTO_TEST_CASE(test_range_proof_recovery_batch_with_foreign_proof)
+{
+    auto msg = GenMsgPair();
+    auto token_id = GenTokenId();
+    bulletproofs::RangeProofLogic<T> rp;
+
+    std::vector<bulletproofs::AmountRecoveryRequest<T>> reqs;
+    for (size_t i = 0; i < 4; ++i) {
+        auto nonce = Point::MapToPoint(strprintf("nonce %d", i));
+        Scalars vs;
+        vs.Add(Scalar(i + 1));
+        auto proof = rp.Prove(vs, nonce, msg.second, token_id);
+        bulletproofs::RangeProofWithSeed<T> proof_with_seed = {proof, token_id};
+
+        // the proof at index 2 was not created with our nonce,
+        // so its commitment check must fail and make the batch check fail
+        auto recovery_nonce = i == 2 ? GenNonce() : nonce;
+        reqs.push_back(bulletproofs::AmountRecoveryRequest<T>::of(proof_with_seed, recovery_nonce));
+    }
+    auto result = rp.RecoverAmounts(reqs);
+
+    BOOST_CHECK(result.is_completed);
+    auto xs = result.amounts;
+    BOOST_REQUIRE(xs.size() == 3);
+    std::vector<size_t> exp_ids{0, 1, 3};
+    for (size_t i = 0; i < xs.size(); ++i) {
+        BOOST_CHECK(xs[i].id == exp_ids[i]);
+        BOOST_CHECK(xs[i].amount == (CAmount)exp_ids[i] + 1);
+        BOOST_CHECK(xs[i].message == msg.first);
+    }
+}
+
 static std::vector<TestCase> BuildTestCases()
 {
     bulletproofs::RangeProofLogic<T> rp;
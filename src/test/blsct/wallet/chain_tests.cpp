@@ -5,7 +5,11 @@
 #include <blsct/wallet/txfactory.h>
 #include <consensus/amount.h>
 #include <consensus/consensus.h>
+#include <kernel/mempool_persist.h>
 #include <policy/fees.h>
+#include <streams.h>
+#include <txmempool.h>
+#include <util/time.h>
 #include <validation.h>
 #include <wallet/coincontrol.h>
 #include <wallet/receive.h>
@@ -57,5 +61,56 @@ BOOST_FIXTURE_TEST_CASE(SyncTest, TestBLSCTChain100Setup)
     BOOST_CHECK(wtx != nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE(MempoolPersistTest, TestBLSCTChain100Setup)
+{
+    CreateAndProcessBlock({});
+    auto wallet = CreateBLSCTWallet(*m_node.chain, WITH_LOCK(Assert(m_node.chainman)->GetMutex(), return m_node.chainman->ActiveChain()));
+
+    auto blsct_km = wallet->GetBLSCTKeyMan();
+    auto walletDestination = blsct::SubAddress(std::get<blsct::DoublePublicKey>(blsct_km->GetNewDestination(0).value()));
+
+    LOCK(wallet->cs_wallet);
+
+    for (size_t i = 0; i <= COINBASE_MATURITY; i++) {
+        CreateAndProcessBlock({}, walletDestination);
+    }
+
+    BOOST_CHECK(SyncBLSCTWallet(wallet, WITH_LOCK(Assert(m_node.chainman)->GetMutex(), return m_node.chainman->ActiveChain())));
+
+    auto tx = blsct::TxFactory::CreateTransaction(wallet.get(), wallet->GetOrCreateBLSCTKeyMan(), blsct::SubAddress(), 1 * COIN, "test");
+    BOOST_REQUIRE(tx != std::nullopt);
+    const auto ptx = MakeTransactionRef(tx.value());
+
+    CTxMemPool& mempool = *Assert(m_node.mempool);
+    Chainstate& chainstate = m_node.chainman->ActiveChainstate();
+    BOOST_REQUIRE_EQUAL(m_node.chainman->ProcessTransaction(ptx).m_result_type, MempoolAcceptResult::ResultType::VALID);
+
+    const auto remove_tx = [&] {
+        LOCK2(cs_main, mempool.cs);
+        mempool.removeRecursive(*ptx, MemPoolRemovalReason::REPLACED);
+        BOOST_REQUIRE(!mempool.exists(GenTxid::Txid(ptx->GetHash())));
+    };
+
+    // The BLSCT transaction is dumped and loaded again
+    const fs::path mempool_path{m_args.GetDataDirNet() / "mempool_blsct.dat"};
+    BOOST_REQUIRE(kernel::DumpMempool(mempool, mempool_path));
+    remove_tx();
+    BOOST_CHECK(kernel::LoadMempool(mempool, mempool_path, chainstate, {}));
+    BOOST_CHECK(mempool.exists(GenTxid::Txid(ptx->GetHash())));
+
+    // A dump which ends in the middle of a batch still loads the transactions
+    // read before its end
+    remove_tx();
+    {
+        AutoFile file{fsbridge::fopen(mempool_path, "wb")};
+        // version without XOR key, then two transactions of which only the
+        // first one is there
+        file << uint64_t{1} << uint64_t{2};
+        file << TX_WITH_WITNESS(*ptx) << int64_t{GetTime()} << int64_t{0} << int64_t{0};
+    }
+    BOOST_CHECK(!kernel::LoadMempool(mempool, mempool_path, chainstate, {}));
+    BOOST_CHECK(mempool.exists(GenTxid::Txid(ptx->GetHash())));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace wallet
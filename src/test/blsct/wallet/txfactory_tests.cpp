@@ -43,6 +43,51 @@ BOOST_FIXTURE_TEST_CASE(ismine_test, TestingSetup)
     BOOST_CHECK(xs[0].message == "test");
 }
 
+BOOST_FIXTURE_TEST_CASE(recoveroutputs_mixed_test, TestingSetup)
+{
+    auto wallet = std::make_unique<wallet::CWallet>(m_node.chain.get(), "", wallet::CreateMockableWalletDatabase());
+    wallet->InitWalletFlags(wallet::WALLET_FLAG_BLSCT);
+    auto other_wallet = std::make_unique<wallet::CWallet>(m_node.chain.get(), "", wallet::CreateMockableWalletDatabase());
+    other_wallet->InitWalletFlags(wallet::WALLET_FLAG_BLSCT);
+
+    LOCK2(wallet->cs_wallet, other_wallet->cs_wallet);
+    auto blsct_km = wallet->GetOrCreateBLSCTKeyMan();
+    BOOST_CHECK(blsct_km->SetupGeneration(true));
+    auto other_km = other_wallet->GetOrCreateBLSCTKeyMan();
+    BOOST_CHECK(other_km->SetupGeneration(true));
+
+    auto recvAddress = std::get<blsct::DoublePublicKey>(blsct_km->GetNewDestination(0).value());
+    auto otherAddress = std::get<blsct::DoublePublicKey>(other_km->GetNewDestination(0).value());
+
+    // Outputs of this wallet mixed with outputs of another one and a
+    // transparent output
+    std::vector<CTxOut> outs{
+        blsct::CreateOutput(otherAddress, 500, "other").out,
+        blsct::CreateOutput(recvAddress, 1000, "first").out,
+        CTxOut{700, CScript{} << OP_TRUE},
+        blsct::CreateOutput(recvAddress, 2000, "second").out,
+        blsct::CreateOutput(otherAddress, 600, "other").out,
+    };
+
+    // Only the own outputs are recovered, identified by their index in outs
+    auto result = blsct_km->RecoverOutputs(outs);
+    BOOST_CHECK(result.is_completed);
+    BOOST_REQUIRE_EQUAL(result.amounts.size(), 2U);
+    BOOST_CHECK_EQUAL(result.amounts[0].id, 1U);
+    BOOST_CHECK_EQUAL(result.amounts[0].amount, 1000);
+    BOOST_CHECK_EQUAL(result.amounts[0].message, "first");
+    BOOST_CHECK_EQUAL(result.amounts[1].id, 3U);
+    BOOST_CHECK_EQUAL(result.amounts[1].amount, 2000);
+    BOOST_CHECK_EQUAL(result.amounts[1].message, "second");
+
+    auto other_result = other_km->RecoverOutputs(outs);
+    BOOST_CHECK(other_result.is_completed);
+    BOOST_REQUIRE_EQUAL(other_result.amounts.size(), 2U);
+    BOOST_CHECK_EQUAL(other_result.amounts[0].id, 0U);
+    BOOST_CHECK_EQUAL(other_result.amounts[1].id, 4U);
+    BOOST_CHECK_EQUAL(other_result.amounts[1].amount, 600);
+}
+
 BOOST_FIXTURE_TEST_CASE(createtransaction_test, TestingSetup)
 {
     SeedInsecureRand(SeedRand::ZEROS);
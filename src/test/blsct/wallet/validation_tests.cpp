@@ -56,6 +56,148 @@ BOOST_FIXTURE_TEST_CASE(validation_test, TestingSetup)
 
     BOOST_CHECK(finalTx.has_value());
     BOOST_CHECK(blsct::VerifyTx(CTransaction(finalTx.value()), coins_view_cache, tx_state));
+
+    // Range proofs verified ahead of the UTXO dependent checks are cached,
+    // and VerifyTx still accepts the transaction using the cached result
+    TxValidationState pre_state;
+    BOOST_CHECK(blsct::PreVerifyTx(CTransaction(finalTx.value()), pre_state));
+    BOOST_CHECK(blsct::PreVerifyTx(CTransaction(finalTx.value()), pre_state));
+    BOOST_CHECK(blsct::VerifyTx(CTransaction(finalTx.value()), coins_view_cache, tx_state));
+
+    // A broken range proof is rejected before the coins are looked at
+    CMutableTransaction tampered{finalTx.value()};
+    for (auto& tampered_out : tampered.vout) {
+        if (!tampered_out.IsBLSCT()) continue;
+        tampered_out.blsctData.rangeProof.t_hat = tampered_out.blsctData.rangeProof.t_hat + MclScalar(1);
+        break;
+    }
+    TxValidationState tampered_state;
+    BOOST_CHECK(!blsct::PreVerifyTx(CTransaction(tampered), tampered_state));
+    BOOST_CHECK_EQUAL(tampered_state.GetRejectReason(), "failed-rangeproof-check");
+    BOOST_CHECK(!blsct::VerifyTx(CTransaction(tampered), coins_view_cache, tampered_state));
+}
+
+BOOST_FIXTURE_TEST_CASE(validation_cut_through_test, TestingSetup)
+{
+    SeedInsecureRand(SeedRand::ZEROS);
+    CCoinsViewDB base{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {}};
+
+    auto wallet = std::make_unique<wallet::CWallet>(m_node.chain.get(), "", wallet::CreateMockableWalletDatabase());
+    wallet->InitWalletFlags(wallet::WALLET_FLAG_BLSCT);
+
+    LOCK(wallet->cs_wallet);
+    auto blsct_km = wallet->GetOrCreateBLSCTKeyMan();
+    BOOST_CHECK(blsct_km->SetupGeneration(true));
+
+    auto recvAddress = std::get<blsct::DoublePublicKey>(blsct_km->GetNewDestination(0).value());
+
+    const auto txid = Txid::FromUint256(InsecureRand256());
+    COutPoint outpoint(txid, /*nIn=*/0);
+
+    Coin coin;
+    auto out = blsct::CreateOutput(recvAddress, 1000 * COIN, "test");
+    coin.nHeight = 1;
+    coin.out = out.out;
+
+    CCoinsViewCache coins_view_cache{&base, /*deterministic=*/true};
+    coins_view_cache.AddCoin(outpoint, std::move(coin), true);
+
+    // parent transaction spending the coin
+    auto parent_factory = blsct::TxFactory(blsct_km);
+    BOOST_CHECK(parent_factory.AddInput(coins_view_cache, outpoint));
+    parent_factory.AddOutput(recvAddress, 900 * COIN, "test");
+    auto parent = MakeTransactionRef(parent_factory.BuildTx().value());
+
+    // child transaction spending an output of the parent
+    CCoinsViewCache chained_view{&coins_view_cache};
+    AddCoins(chained_view, *parent, 2);
+    uint32_t n = 0;
+    while (!parent->vout[n].IsBLSCT()) ++n;
+
+    auto child_factory = blsct::TxFactory(blsct_km);
+    BOOST_CHECK(child_factory.AddInput(chained_view, COutPoint(parent->GetHash(), n)));
+    child_factory.AddOutput(recvAddress, 100 * COIN, "test");
+    auto child = MakeTransactionRef(child_factory.BuildTx().value());
+
+    TxValidationState child_state;
+    BOOST_CHECK(blsct::VerifyTx(*child, chained_view, child_state));
+
+    // the spent output of the parent is only available with cut-through
+    auto concatenated = blsct::AggregateTransactions({parent, child});
+    TxValidationState concatenated_state;
+    BOOST_CHECK(!concatenated->HasCutThrough());
+    BOOST_CHECK(!blsct::VerifyTx(*concatenated, coins_view_cache, concatenated_state));
+
+    auto aggregated = blsct::AggregateTransactions({parent, child}, /*fCutThrough=*/true);
+    TxValidationState aggregated_state;
+    BOOST_CHECK(aggregated->HasCutThrough());
+    BOOST_CHECK_EQUAL(aggregated->vin.size(), parent->vin.size());
+    BOOST_CHECK_EQUAL(aggregated->vout.size(), concatenated->vout.size() - 1);
+    BOOST_CHECK_EQUAL(aggregated->vCutThrough.size(), 2);
+    BOOST_CHECK(blsct::VerifyTx(*aggregated, coins_view_cache, aggregated_state));
+
+    // the cached input and output hashes match the ones of the inputs and outputs
+    for (size_t i = 0; i < aggregated->vin.size(); ++i) {
+        BOOST_CHECK(aggregated->GetInHash(i) == aggregated->vin[i].GetHash());
+    }
+    for (size_t i = 0; i < aggregated->vout.size(); ++i) {
+        BOOST_CHECK(aggregated->GetOutHash(i) == aggregated->vout[i].GetHash());
+    }
+
+    // the cut-through terms survive a serialization round trip
+    DataStream ss{};
+    ss << TX_WITH_WITNESS(*aggregated);
+    CMutableTransaction decoded;
+    ss >> TX_WITH_WITNESS(decoded);
+    BOOST_CHECK(CTransaction(decoded).GetHash() == aggregated->GetHash());
+    BOOST_CHECK(decoded.vCutThrough == aggregated->vCutThrough);
+
+    // extending a running aggregate gives the same transaction
+    blsct::TxAggregator aggregator{/*fCutThrough=*/true};
+    aggregator.Add(parent);
+    BOOST_CHECK_EQUAL(aggregator.Size(), 1);
+    aggregator.Add(child);
+    auto extended = aggregator.GetTransaction();
+    BOOST_CHECK(extended->GetHash() == aggregated->GetHash());
+    BOOST_CHECK(extended->txSig == aggregated->txSig);
+
+    // aggregating a tx which already has cut-through terms keeps them
+    const auto other_txid = Txid::FromUint256(InsecureRand256());
+    COutPoint other_outpoint(other_txid, /*nIn=*/0);
+    Coin other_coin;
+    other_coin.nHeight = 1;
+    other_coin.out = blsct::CreateOutput(recvAddress, 500 * COIN, "test").out;
+    coins_view_cache.AddCoin(other_outpoint, std::move(other_coin), true);
+
+    auto other_factory = blsct::TxFactory(blsct_km);
+    BOOST_CHECK(other_factory.AddInput(coins_view_cache, other_outpoint));
+    other_factory.AddOutput(recvAddress, 400 * COIN, "test");
+    auto other = MakeTransactionRef(other_factory.BuildTx().value());
+
+    auto reaggregated = blsct::AggregateTransactions({aggregated, other}, /*fCutThrough=*/true);
+    TxValidationState reaggregated_state;
+    BOOST_CHECK_EQUAL(reaggregated->vin.size(), aggregated->vin.size() + other->vin.size());
+    BOOST_CHECK(reaggregated->vCutThrough == aggregated->vCutThrough);
+    BOOST_CHECK(blsct::VerifyTx(*reaggregated, coins_view_cache, reaggregated_state));
+
+    // removing a tx from a running aggregate gives the aggregate of the
+    // others, once the txs cutting through its outputs are removed
+    aggregator.Add(other);
+    BOOST_CHECK(!aggregator.Remove(parent->GetHash()));
+    BOOST_CHECK(aggregator.Remove(child->GetHash()));
+    BOOST_CHECK(!aggregator.Remove(child->GetHash()));
+    auto reduced = aggregator.GetTransaction();
+    auto expected = blsct::AggregateTransactions({parent, other}, /*fCutThrough=*/true);
+    BOOST_CHECK_EQUAL(aggregator.Size(), 2);
+    BOOST_CHECK(reduced->GetHash() == expected->GetHash());
+    BOOST_CHECK(reduced->txSig == expected->txSig);
+
+    // adding the child again cuts through the output of the parent again
+    aggregator.Add(child);
+    auto readded = aggregator.GetTransaction();
+    TxValidationState readded_state;
+    BOOST_CHECK_EQUAL(readded->vCutThrough.size(), 2);
+    BOOST_CHECK(blsct::VerifyTx(*readded, coins_view_cache, readded_state));
 }
 
 BOOST_FIXTURE_TEST_CASE(validation_reward_test, TestingSetup)
@@ -1093,6 +1093,30 @@ BOOST_AUTO_TEST_CASE(ccoins_flush_behavior)
     }
 }
 
+BOOST_AUTO_TEST_CASE(coin_blsct_dynamic_memory_usage)
+{
+    Coin coin;
+    coin.out.nValue = 0;
+    const size_t script_usage = coin.DynamicMemoryUsage();
+
+    // The range proof elements are heap allocated and have to be accounted for
+    for (size_t i = 0; i < 8; ++i) {
+        coin.out.blsctData.rangeProof.Ls.Add(MclG1Point::Rand());
+        coin.out.blsctData.rangeProof.Rs.Add(MclG1Point::Rand());
+    }
+    coin.out.blsctData.rangeProof.Vs.Add(MclG1Point::Rand());
+    BOOST_CHECK(coin.DynamicMemoryUsage() >= script_usage + 17 * sizeof(MclG1Point));
+
+    CCoinsViewDB base{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {}};
+    CCoinsViewCacheTest cache{&base};
+    const size_t empty_usage = cache.DynamicMemoryUsage();
+
+    COutPoint outpoint{Txid::FromUint256(InsecureRand256()), 0};
+    cache.AddCoin(outpoint, Coin{coin}, /*possible_overwrite=*/false);
+    BOOST_CHECK(cache.DynamicMemoryUsage() >= empty_usage + coin.DynamicMemoryUsage());
+    cache.SelfTest();
+}
+
 /** TODO: Make sure to fix this test when BLSCT is done */
 #ifdef false
 BOOST_AUTO_TEST_CASE(coins_resource_is_used)
@@ -6,6 +6,7 @@
 #include <index/coinstatsindex.h>
 #include <interfaces/chain.h>
 #include <kernel/coinstats.h>
+#include <node/blockstorage.h>
 #include <test/util/index.h>
 #include <test/util/setup_common.h>
 #include <test/util/validation.h>
@@ -13,6 +14,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <functional>
+
 BOOST_AUTO_TEST_SUITE(coinstatsindex_tests)
 
 BOOST_FIXTURE_TEST_CASE(coinstatsindex_initial_sync, TestChain100Setup)
@@ -118,4 +121,61 @@ BOOST_FIXTURE_TEST_CASE(coinstatsindex_unclean_shutdown, TestChain100Setup)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(coinstatsindex_blsct_muhash, TestBLSCTChain100Setup)
+{
+    CoinStatsIndex coin_stats_index{interfaces::MakeChain(m_node), 1 << 20, true};
+    BOOST_REQUIRE(coin_stats_index.Init());
+    BOOST_REQUIRE(coin_stats_index.StartBackgroundSync());
+    IndexWaitSynced(coin_stats_index, *Assert(m_node.shutdown));
+
+    // New blocks are hashed through the validation interface rather than by
+    // the initial sync.
+    for (int i = 0; i < 5; i++) {
+        CreateAndProcessBlock({});
+    }
+    BOOST_REQUIRE(coin_stats_index.BlockUntilSyncedToCurrentChain());
+
+    // The running MuHash of the index matches a full scan of the UTXO set.
+    Chainstate& chainstate = Assert(m_node.chainman)->ActiveChainstate();
+    const CBlockIndex* tip = WITH_LOCK(::cs_main, return chainstate.m_chain.Tip());
+    const auto index_stats{coin_stats_index.LookUpStats(*tip)};
+    BOOST_REQUIRE(index_stats);
+    CCoinsView* coins_view = WITH_LOCK(::cs_main, chainstate.ForceFlushStateToDisk(); return &chainstate.CoinsDB());
+    const auto utxo_stats{kernel::ComputeUTXOStats(kernel::CoinStatsHashType::MUHASH, coins_view, m_node.chainman->m_blockman)};
+    BOOST_REQUIRE(utxo_stats);
+    BOOST_CHECK_EQUAL(index_stats->hashSerialized, utxo_stats->hashSerialized);
+    BOOST_CHECK_EQUAL(index_stats->nTransactionOutputs, utxo_stats->nTransactionOutputs);
+
+    CBlock block;
+    BOOST_REQUIRE(m_node.chainman->m_blockman.ReadBlockFromDisk(block, *tip));
+    const auto& coinbase_outs{block.vtx[0]->vout};
+    const auto it{std::find_if(coinbase_outs.begin(), coinbase_outs.end(), [](const CTxOut& out) { return out.IsBLSCT(); })};
+    BOOST_REQUIRE(it != coinbase_outs.end());
+    const COutPoint outpoint{block.vtx[0]->GetHash(), static_cast<uint32_t>(it - coinbase_outs.begin())};
+    const Coin coin{*it, tip->nHeight, /*fCoinBaseIn=*/true};
+
+    const auto hash_coin = [&](const Coin& c) {
+        MuHash3072 muhash;
+        kernel::ApplyCoinHash(muhash, outpoint, c);
+        uint256 hash;
+        muhash.Finalize(hash);
+        return hash;
+    };
+
+    // Every field of the BLSCT data is committed to
+    const auto check_changes_hash = [&](const std::function<void(CTxOutBLSCTData&)>& change) {
+        Coin changed{coin};
+        change(changed.out.blsctData);
+        BOOST_CHECK(hash_coin(coin) != hash_coin(changed));
+    };
+    check_changes_hash([](CTxOutBLSCTData& data) { data.viewTag ^= 1; });
+    check_changes_hash([](CTxOutBLSCTData& data) { data.blindingKey = MclG1Point::MapToPoint("blinding"); });
+    check_changes_hash([](CTxOutBLSCTData& data) { data.ephemeralKey = MclG1Point::MapToPoint("ephemeral"); });
+    check_changes_hash([](CTxOutBLSCTData& data) { data.spendingKey = MclG1Point::MapToPoint("spending"); });
+    check_changes_hash([](CTxOutBLSCTData& data) { data.rangeProof.A = MclG1Point::MapToPoint("range proof"); });
+
+    SyncWithValidationInterfaceQueue();
+    coin_stats_index.Stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -115,6 +115,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "getaddrmaninfo",
     "getbestblockhash",
     "getblock",
+    "getblockcacheinfo",
     "getblockchaininfo",
     "getblockcount",
     "getblockfilter",
@@ -150,6 +151,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "gettxout",
     "gettxoutsetinfo",
     "gettxspendingprevout",
+    "getviewtags",
     "help",
     "invalidateblock",
     "joinpsbts",
@@ -0,0 +1,199 @@
+// Copyright (c) 2024 The Navio Core developers
+// Distributed under the MIT software license. See the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <addresstype.h>
+#include <chain.h>
+#include <common/args.h>
+#include <consensus/validation.h>
+#include <index/base.h>
+#include <interfaces/chain.h>
+#include <key.h>
+#include <sync.h>
+#include <test/util/index.h>
+#include <test/util/setup_common.h>
+#include <util/fs.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <any>
+#include <condition_variable>
+#include <map>
+
+namespace {
+
+/**
+ * Index that records the block it was handed for every height, and that can
+ * hold the sync thread inside CustomAppendPrepared at a given height so the
+ * test can change the chain or interrupt the sync while blocks are being
+ * prefetched.
+ */
+class SyncTestIndex : public BaseIndex
+{
+    std::unique_ptr<BaseIndex::DB> m_db;
+
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::map<int, uint256> m_appended GUARDED_BY(m_mutex);
+    int m_pause_height GUARDED_BY(m_mutex){-1};
+    bool m_paused GUARDED_BY(m_mutex){false};
+    bool m_bad_prepared GUARDED_BY(m_mutex){false};
+
+protected:
+    bool AllowPrune() const override { return false; }
+    DB& GetDB() const override { return *m_db; }
+
+    std::any CustomPrepare(const interfaces::BlockInfo& block) const override
+    {
+        return block.hash;
+    }
+
+    bool CustomAppendPrepared(const interfaces::BlockInfo& block, std::any&& prepared) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        // The prefetcher must hand back the result prepared for this very block
+        if (std::any_cast<uint256>(prepared) != block.hash) m_bad_prepared = true;
+        m_appended[block.height] = block.hash;
+        if (block.height == m_pause_height) {
+            m_paused = true;
+            m_cv.notify_all();
+            m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_pause_height != block.height; });
+        }
+        return true;
+    }
+
+    bool CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_appended.erase(m_appended.upper_bound(new_tip.height), m_appended.end());
+        return true;
+    }
+
+public:
+    SyncTestIndex(std::unique_ptr<interfaces::Chain> chain, const fs::path& path, bool f_wipe)
+        : BaseIndex(std::move(chain), "synctestindex"),
+          m_db{std::make_unique<BaseIndex::DB>(path, 1 << 20, /*f_memory=*/false, f_wipe)} {}
+
+    ~SyncTestIndex() override
+    {
+        Unpause();
+        Interrupt();
+        Stop();
+    }
+
+    void PauseAt(int height) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_pause_height = height;
+    }
+
+    void WaitPaused() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_paused; });
+    }
+
+    void Unpause() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WITH_LOCK(m_mutex, m_pause_height = -1);
+        m_cv.notify_all();
+    }
+
+    std::map<int, uint256> GetAppended() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        return m_appended;
+    }
+
+    bool HadBadPrepared() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        return m_bad_prepared;
+    }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(index_sync_tests)
+
+//! Check that the index holds exactly the active chain from the given height
+static void CheckIndexedActiveChain(const ChainstateManager& chainman, const std::map<int, uint256>& appended, int from_height)
+{
+    LOCK(cs_main);
+    const CChain& chain{chainman.ActiveChain()};
+    BOOST_CHECK_EQUAL(appended.size(), static_cast<size_t>(chain.Height() - from_height + 1));
+    for (int height = from_height; height <= chain.Height(); ++height) {
+        const auto it{appended.find(height)};
+        BOOST_REQUIRE(it != appended.end());
+        BOOST_CHECK_EQUAL(it->second, chain[height]->GetBlockHash());
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(index_sync_reorg, TestChain100Setup)
+{
+    SyncTestIndex index{interfaces::MakeChain(m_node), gArgs.GetDataDirNet() / "indexes" / "synctestindex", /*f_wipe=*/true};
+    BOOST_REQUIRE(index.Init());
+
+    // Hold the sync thread once it appended block 55. By then the blocks
+    // after it are being prefetched.
+    index.PauseAt(55);
+    BOOST_REQUIRE(index.StartBackgroundSync());
+    index.WaitPaused();
+
+    // Reorg away from block 52 while the index is past it, so the sync has
+    // to rewind the index and drop the blocks it already prefetched.
+    {
+        BlockValidationState state;
+        CBlockIndex* pindex{WITH_LOCK(cs_main, return m_node.chainman->ActiveChain()[52])};
+        BOOST_REQUIRE(m_node.chainman->ActiveChainstate().InvalidateBlock(state, pindex));
+        BOOST_CHECK_EQUAL(WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Height()), 51);
+    }
+    const CScript fork_script{GetScriptForDestination(PKHash(GenerateRandomKey().GetPubKey()))};
+    for (int i = 0; i < 10; ++i) {
+        CreateAndProcessBlock({}, fork_script);
+    }
+
+    index.Unpause();
+    IndexWaitSynced(index, *Assert(m_node.shutdown));
+
+    BOOST_CHECK(!index.HadBadPrepared());
+    CheckIndexedActiveChain(*m_node.chainman, index.GetAppended(), /*from_height=*/0);
+    BOOST_CHECK_EQUAL(index.GetSummary().best_block_height, 61);
+}
+
+BOOST_FIXTURE_TEST_CASE(index_sync_interrupt, TestChain100Setup)
+{
+    const fs::path path{gArgs.GetDataDirNet() / "indexes" / "synctestindex"};
+    {
+        SyncTestIndex index{interfaces::MakeChain(m_node), path, /*f_wipe=*/true};
+        BOOST_REQUIRE(index.Init());
+
+        // Interrupt the sync while blocks after 30 are being prefetched. The
+        // index stops right after the block it is appending.
+        index.PauseAt(30);
+        BOOST_REQUIRE(index.StartBackgroundSync());
+        index.WaitPaused();
+        index.Interrupt();
+        index.Unpause();
+        index.Stop();
+
+        const IndexSummary summary{index.GetSummary()};
+        BOOST_CHECK(!summary.synced);
+        BOOST_CHECK_EQUAL(summary.best_block_height, 30);
+        BOOST_CHECK(!index.HadBadPrepared());
+        BOOST_CHECK_EQUAL(index.GetAppended().size(), 31U);
+    }
+
+    // A restarted index picks up from the committed block
+    SyncTestIndex index{interfaces::MakeChain(m_node), path, /*f_wipe=*/false};
+    BOOST_REQUIRE(index.Init());
+    BOOST_REQUIRE(index.StartBackgroundSync());
+    IndexWaitSynced(index, *Assert(m_node.shutdown));
+
+    BOOST_CHECK(!index.HadBadPrepared());
+    CheckIndexedActiveChain(*m_node.chainman, index.GetAppended(), /*from_height=*/31);
+    BOOST_CHECK_EQUAL(index.GetSummary().best_block_height, 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+// Copyright (c) 2024 The Navio developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chain.h>
+#include <common/json_writer.h>
+#include <core_io.h>
+#include <node/blockstorage.h>
+#include <rpc/blockchain.h>
+#include <test/util/setup_common.h>
+#include <univalue.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using common::JSONWriter;
+
+BOOST_FIXTURE_TEST_SUITE(json_writer_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(json_writer_matches_univalue)
+{
+    UniValue inner(UniValue::VOBJ);
+    inner.pushKV("a\"b", "quote\n");
+    inner.pushKV("empty_array", UniValue(UniValue::VARR));
+    inner.pushKV("empty_object", UniValue(UniValue::VOBJ));
+    UniValue array(UniValue::VARR);
+    array.push_back(1);
+    array.push_back(inner);
+    array.push_back(UniValue());
+
+    UniValue expected(UniValue::VOBJ);
+    expected.pushKV("number", 1.5);
+    expected.pushKV("bool", true);
+    expected.pushKV("array", array);
+    expected.pushKV("object", inner);
+
+    // A flush size of one hands every piece to the sink as soon as it is written.
+    for (const size_t flush_size : {size_t{1}, JSONWriter::DEFAULT_FLUSH_SIZE}) {
+        std::string out;
+        int flushes{0};
+        JSONWriter writer{[&](std::string&& chunk) { out += chunk; ++flushes; }, flush_size};
+        writer.BeginObject();
+        writer.Key("number");
+        writer.Value(1.5);
+        writer.Key("bool");
+        writer.Value(true);
+        writer.Key("array");
+        writer.BeginArray();
+        writer.Value(1);
+        writer.Value(inner);
+        writer.Value(UniValue());
+        writer.EndArray();
+        writer.Key("object");
+        writer.BeginObject();
+        writer.Members(inner);
+        writer.EndObject();
+        writer.EndObject();
+        out += writer.Finish();
+
+        BOOST_CHECK_EQUAL(out, expected.write());
+        BOOST_CHECK_EQUAL(flushes > 0, flush_size == 1);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(json_writer_block, TestChain100Setup)
+{
+    const CBlockIndex* tip = WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain().Tip());
+    CBlock block;
+    BOOST_REQUIRE(m_node.chainman->m_blockman.ReadBlockFromDisk(block, *tip->pprev));
+
+    for (const TxVerbosity verbosity : {TxVerbosity::SHOW_TXID, TxVerbosity::SHOW_DETAILS, TxVerbosity::SHOW_DETAILS_AND_PREVOUT}) {
+        std::string out;
+        JSONWriter writer{[&](std::string&& chunk) { out += chunk; }, /*flush_size=*/64};
+        blockToJSON(m_node.chainman->m_blockman, block, *tip, *tip->pprev, verbosity, writer);
+        out += writer.Finish();
+        BOOST_CHECK_EQUAL(out, blockToJSON(m_node.chainman->m_blockman, block, *tip, *tip->pprev, verbosity).write());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,6 +12,7 @@
 #include <test/util/setup_common.h>
 #include <univalue.h>
 #include <util/time.h>
+#include <validation.h>
 
 #include <any>
 
@@ -131,6 +132,40 @@ BOOST_AUTO_TEST_CASE(rpc_namedonlyparams)
                           HasJSON(R"({"code":-8,"message":"Parameter options specified twice both as positional and named argument"})"));
 }
 
+BOOST_AUTO_TEST_CASE(rpc_parallel_batch)
+{
+    // Read-only methods opt in to running at the same time, others do not
+    BOOST_CHECK(tableRPC.IsParallelBatchSafe("getblock"));
+    BOOST_CHECK(tableRPC.IsParallelBatchSafe("getblockhash"));
+    BOOST_CHECK(tableRPC.IsParallelBatchSafe("getrawtransaction"));
+    BOOST_CHECK(!tableRPC.IsParallelBatchSafe("sendrawtransaction"));
+    BOOST_CHECK(!tableRPC.IsParallelBatchSafe("setnetworkactive"));
+    BOOST_CHECK(!tableRPC.IsParallelBatchSafe("invalidmethod"));
+
+    // Results are in the order of the calls, around calls that run alone
+    if (RPCIsInWarmup(nullptr)) SetRPCWarmupFinished();
+    JSONRPCRequest jreq;
+    jreq.context = &m_node;
+    const UniValue reply{JSON(JSONRPCExecBatch(jreq, JSON(R"([
+        {"method": "getblockhash", "params": [0], "id": 1},
+        {"method": "getblockcount", "id": 2},
+        {"method": "getmempoolinfo", "id": 3},
+        {"method": "getblockhash", "params": [1], "id": 4},
+        {"method": "getbestblockhash", "id": 5},
+        "not a call"
+    ])")))};
+    BOOST_REQUIRE_EQUAL(reply.size(), 6U);
+    for (size_t i = 0; i < 5; ++i) {
+        BOOST_CHECK_EQUAL(reply[i].find_value("id").getInt<size_t>(), i + 1);
+    }
+    BOOST_CHECK_EQUAL(reply[0].find_value("result").get_str(), m_node.chainman->GetParams().GenesisBlock().GetHash().GetHex());
+    BOOST_CHECK_EQUAL(reply[1].find_value("result").getInt<int>(), 0);
+    BOOST_CHECK(reply[2].find_value("result").isObject());
+    BOOST_CHECK_EQUAL(reply[3].find_value("error").find_value("code").getInt<int>(), RPC_INVALID_PARAMETER);
+    BOOST_CHECK_EQUAL(reply[4].find_value("result").get_str(), reply[0].find_value("result").get_str());
+    BOOST_CHECK_EQUAL(reply[5].find_value("error").find_value("code").getInt<int>(), RPC_INVALID_REQUEST);
+}
+
 BOOST_AUTO_TEST_CASE(rpc_rawparams)
 {
     // Test raw transaction API argument handling
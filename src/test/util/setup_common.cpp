@@ -9,6 +9,7 @@
 #include <addrman.h>
 #include <banman.h>
 #include <blsct/wallet/txfactory_global.h>
+#include <blsct/wallet/verification.h>
 #include <chainparams.h>
 #include <common/system.h>
 #include <common/url.h>
@@ -147,6 +148,7 @@ BasicTestingSetup::BasicTestingSetup(const ChainType chainType, const std::vecto
     ApplyArgsManOptions(*m_node.args, validation_cache_sizes);
     Assert(InitSignatureCache(validation_cache_sizes.signature_cache_bytes));
     Assert(InitScriptExecutionCache(validation_cache_sizes.script_execution_cache_bytes));
+    Assert(blsct::InitRangeProofCache(DEFAULT_MAX_RANGE_PROOF_CACHE_BYTES));
 
     m_node.chain = interfaces::MakeChain(m_node);
     static bool noui_connected = false;
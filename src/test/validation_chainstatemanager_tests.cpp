@@ -20,14 +20,18 @@
 #include <validation.h>
 #include <validationinterface.h>
 
+#include <streams.h>
 #include <tinyformat.h>
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
 
 using node::BlockManager;
 using node::KernelNotifications;
+using node::SnapshotChunk;
 using node::SnapshotMetadata;
 
 BOOST_FIXTURE_TEST_SUITE(validation_chainstatemanager_tests, TestingSetup)
@@ -224,14 +228,10 @@ struct SnapshotTestSetup : TestChain100Setup {
         // Should not load malleated snapshots
         BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
             this, [](AutoFile& auto_infile, SnapshotMetadata& metadata) {
-                // A UTXO is missing but count is correct
-                metadata.m_coins_count -= 1;
-
-                COutPoint outpoint;
-                Coin coin;
-
-                auto_infile >> outpoint;
-                auto_infile >> coin;
+                // A chunk of coins is missing but count is correct
+                SnapshotChunk chunk;
+                auto_infile >> chunk;
+                metadata.m_coins_count -= chunk.m_coins_count;
         }));
 
         BOOST_CHECK(!node::FindSnapshotChainstateDir(chainman.m_options.datadir));
@@ -256,6 +256,11 @@ struct SnapshotTestSetup : TestChain100Setup {
                 // Wrong hash
                 metadata.m_base_blockhash = uint256::ONE;
         }));
+        BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
+            this, [](AutoFile& auto_infile, SnapshotMetadata& metadata) {
+                // Staked commitment without a staked coin
+                metadata.m_staked_commitments.Add(MclG1Point::MapToPoint("staked"));
+        }));
 
         BOOST_REQUIRE(CreateAndActivateUTXOSnapshot(this));
         BOOST_CHECK(fs::exists(*node::FindSnapshotChainstateDir(chainman.m_options.datadir)));
@@ -775,4 +780,53 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_snapshot_completion_hash_mismatch, Sna
     }
 }
 
+//! Round-trip the BLSCT coins and staked commitments of a chainstate through
+//! the parts of the snapshot format.
+BOOST_FIXTURE_TEST_CASE(snapshot_chunk_blsct, TestBLSCTChain100Setup)
+{
+    Chainstate& chainstate = m_node.chainman->ActiveChainstate();
+    CCoinsViewDB& coins_db = *WITH_LOCK(::cs_main, chainstate.ForceFlushStateToDisk(); return &chainstate.CoinsDB());
+
+    std::vector<std::pair<COutPoint, Coin>> coins;
+    std::unique_ptr<CCoinsViewCursor> cursor{coins_db.Cursor()};
+    for (; cursor->Valid(); cursor->Next()) {
+        auto& [outpoint, coin] = coins.emplace_back();
+        BOOST_REQUIRE(cursor->GetKey(outpoint) && cursor->GetValue(coin));
+    }
+    BOOST_REQUIRE(std::any_of(coins.begin(), coins.end(), [](const auto& c) { return c.second.out.IsBLSCT(); }));
+
+    DataStream stream{};
+    stream << SnapshotChunk{coins};
+    SnapshotChunk chunk;
+    stream >> chunk;
+    BOOST_CHECK_EQUAL(chunk.m_coins_count, coins.size());
+
+    std::vector<std::pair<COutPoint, Coin>> decoded;
+    BOOST_REQUIRE(chunk.GetCoins(decoded));
+    BOOST_REQUIRE_EQUAL(decoded.size(), coins.size());
+    BOOST_CHECK(decoded.front().first == coins.front().first);
+    BOOST_CHECK_EQUAL(SnapshotChunk{decoded}.m_checksum, chunk.m_checksum);
+
+    // Corrupted chunks and chunks with a wrong count are rejected.
+    SnapshotChunk corrupted{chunk};
+    corrupted.m_coins[corrupted.m_coins.size() / 2] ^= 1;
+    BOOST_CHECK(!corrupted.GetCoins(decoded));
+    SnapshotChunk miscounted{chunk};
+    miscounted.m_coins_count -= 1;
+    BOOST_CHECK(!miscounted.GetCoins(decoded));
+
+    // The staked commitments travel in the metadata.
+    const SnapshotMetadata metadata{WITH_LOCK(::cs_main, return chainstate.m_chain.Tip()->GetBlockHash()), coins.size(), coins_db.GetStakedCommitments()};
+    stream << metadata;
+    SnapshotMetadata read_metadata;
+    stream >> read_metadata;
+    BOOST_CHECK_EQUAL(read_metadata.m_base_blockhash, metadata.m_base_blockhash);
+    BOOST_CHECK_EQUAL(read_metadata.m_coins_count, metadata.m_coins_count);
+    BOOST_CHECK(read_metadata.m_staked_commitments.m_set == metadata.m_staked_commitments.m_set);
+
+    // Files that are not snapshots are refused.
+    stream << uint8_t{0} << metadata;
+    BOOST_CHECK_THROW(stream >> read_metadata, std::ios_base::failure);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
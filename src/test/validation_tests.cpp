@@ -2,10 +2,15 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <blsct/arith/mcl/mcl.h>
 #include <chainparams.h>
 #include <consensus/amount.h>
 #include <net.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <random.h>
 #include <signet.h>
+#include <streams.h>
 #include <uint256.h>
 #include <util/chaintype.h>
 #include <validation.h>
@@ -14,6 +19,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <ios>
+
 BOOST_FIXTURE_TEST_SUITE(validation_tests, TestingSetup)
 
 static void TestBlockSubsidyHalvings(const Consensus::Params& consensusParams)
@@ -145,4 +153,89 @@ BOOST_AUTO_TEST_CASE(test_assumeutxo)
     BOOST_CHECK_EQUAL(out110_2.nChainTx, 111U);
 }
 
+//! Replace the serialization of a point in a stream with another encoding.
+static void ReplacePoint(DataStream& stream, const MclG1Point& point, const std::vector<uint8_t>& encoding)
+{
+    const auto point_vch{point.GetVch()};
+    const auto data{MakeWritableByteSpan(stream)};
+    const auto it{std::search(data.begin(), data.end(), MakeByteSpan(point_vch).begin(), MakeByteSpan(point_vch).end())};
+    BOOST_REQUIRE(it != data.end());
+    std::copy(MakeByteSpan(encoding).begin(), MakeByteSpan(encoding).end(), it);
+}
+
+BOOST_AUTO_TEST_CASE(blsct_point_subgroup_checks)
+{
+    // Look for a compressed encoding of a point on the curve which is not in
+    // the prime order subgroup
+    std::vector<uint8_t> bad_point(MclG1Point::SERIALIZATION_SIZE, 0);
+    bad_point[0] = 0x80;
+    bool found{false};
+    for (uint8_t x = 1; x < 255 && !found; ++x) {
+        bad_point.back() = x;
+        MclG1Point::DeferredOrderChecks deferred_checks;
+        MclG1Point point;
+        found = point.SetVch(bad_point) && !deferred_checks.points.at(0).IsValidOrder();
+    }
+    BOOST_REQUIRE(found);
+
+    const MclG1Point spending_key{MclG1Point::Rand()};
+    CMutableTransaction mtx;
+    mtx.vin.emplace_back(COutPoint{Txid::FromUint256(GetRandHash()), 0});
+    mtx.vout.emplace_back();
+    mtx.vout[0].blsctData.rangeProof.Vs.Add(MclG1Point::Rand());
+    mtx.vout[0].blsctData.spendingKey = spending_key;
+    const CTransactionRef tx{MakeTransactionRef(mtx)};
+
+    // A loose transaction with the point fails to deserialize
+    {
+        DataStream stream{};
+        stream << TX_WITH_WITNESS(*tx);
+        ReplacePoint(stream, spending_key, bad_point);
+        CMutableTransaction bad_tx;
+        BOOST_CHECK_EXCEPTION(stream >> TX_WITH_WITNESS(bad_tx), std::ios_base::failure, HasReason("G1 point not in the prime order subgroup"));
+    }
+
+    CMutableTransaction coinbase;
+    coinbase.vin.emplace_back();
+    coinbase.vin[0].prevout.SetNull();
+    coinbase.vin[0].scriptSig = CScript() << OP_0 << OP_0;
+    coinbase.vout.emplace_back(0, CScript() << OP_TRUE);
+    CBlock block;
+    block.vtx = {MakeTransactionRef(coinbase), tx};
+
+    const auto read_block{[&](DataStream& stream) {
+        CBlock read;
+        MclG1Point::DeferredOrderChecks deferred_checks;
+        stream >> TX_WITH_WITNESS(read);
+        read.vDeferredPoints = std::move(deferred_checks.points);
+        return read;
+    }};
+    const auto& consensus{m_node.chainman->GetConsensus()};
+
+    // In a block the check is deferred to CheckBlock, which rejects the block
+    {
+        DataStream stream{};
+        stream << TX_WITH_WITNESS(block);
+        ReplacePoint(stream, spending_key, bad_point);
+        const CBlock bad_block{read_block(stream)};
+        BOOST_CHECK(!bad_block.vDeferredPoints.empty());
+        BlockValidationState state;
+        BOOST_CHECK(!CheckBlock(bad_block, state, consensus, /*fCheckPOW=*/false, /*fCheckMerkleRoot=*/false));
+        BOOST_CHECK_EQUAL(state.GetRejectReason(), "bad-blsct-point");
+        BOOST_CHECK(bad_block.vDeferredPoints.empty());
+    }
+
+    // Valid points pass the check and are dropped after it
+    {
+        DataStream stream{};
+        stream << TX_WITH_WITNESS(block);
+        const CBlock good_block{read_block(stream)};
+        BOOST_CHECK(!good_block.vDeferredPoints.empty());
+        BlockValidationState state;
+        CheckBlock(good_block, state, consensus, /*fCheckPOW=*/false, /*fCheckMerkleRoot=*/false);
+        BOOST_CHECK(state.GetRejectReason() != "bad-blsct-point");
+        BOOST_CHECK(good_block.vDeferredPoints.empty());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
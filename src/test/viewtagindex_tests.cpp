@@ -0,0 +1,101 @@
+// Copyright (c) 2024 The Navio developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chain.h>
+#include <index/viewtagindex.h>
+#include <interfaces/chain.h>
+#include <node/blockstorage.h>
+#include <test/util/index.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(viewtagindex_tests)
+
+static void CheckEntries(const node::BlockManager& blockman, const CBlockIndex& block_index, const ViewTagEntries& entries)
+{
+    CBlock block;
+    BOOST_REQUIRE(blockman.ReadBlockFromDisk(block, block_index));
+    BOOST_CHECK_EQUAL(entries.block_hash, block_index.GetBlockHash());
+
+    size_t i = 0;
+    for (const auto& tx : block.vtx) {
+        for (uint32_t n = 0; n < tx->vout.size(); ++n) {
+            const CTxOut& out = tx->vout[n];
+            if (!out.IsBLSCT()) continue;
+
+            BOOST_REQUIRE(i < entries.size());
+            BOOST_CHECK_EQUAL(entries.view_tags[i], out.blsctData.viewTag);
+            BOOST_CHECK(entries.outpoints[i] == COutPoint(tx->GetHash(), n));
+
+            MclG1Point blinding_key, spending_key;
+            BOOST_CHECK(blinding_key.SetVch(Span<const uint8_t>{entries.blinding_keys[i]}));
+            BOOST_CHECK(spending_key.SetVch(Span<const uint8_t>{entries.spending_keys[i]}));
+            BOOST_CHECK(blinding_key == out.blsctData.blindingKey);
+            BOOST_CHECK(spending_key == out.blsctData.spendingKey);
+            ++i;
+        }
+    }
+    BOOST_CHECK_EQUAL(entries.size(), i);
+    BOOST_CHECK_EQUAL(entries.blinding_keys.size(), i);
+    BOOST_CHECK_EQUAL(entries.outpoints.size(), i);
+    BOOST_CHECK_EQUAL(entries.spending_keys.size(), i);
+}
+
+BOOST_FIXTURE_TEST_CASE(viewtagindex_initial_sync, TestBLSCTChain100Setup)
+{
+    ViewTagIndex viewtagindex(interfaces::MakeChain(m_node), 1 << 20, true);
+    BOOST_REQUIRE(viewtagindex.Init());
+
+    const CBlockIndex* tip = WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain().Tip());
+    std::vector<ViewTagEntries> entries;
+
+    // Nothing should be found in the index before it is started.
+    BOOST_CHECK(!viewtagindex.LookUpViewTags(0, tip, entries));
+
+    BOOST_REQUIRE(viewtagindex.StartBackgroundSync());
+    IndexWaitSynced(viewtagindex, *Assert(m_node.shutdown));
+
+    // Every block of the chain is indexed, including the genesis block.
+    BOOST_REQUIRE(viewtagindex.LookUpViewTags(0, tip, entries));
+    BOOST_REQUIRE_EQUAL(entries.size(), static_cast<size_t>(tip->nHeight + 1));
+    size_t outputs = 0;
+    for (const CBlockIndex* block_index = tip; block_index; block_index = block_index->pprev) {
+        CheckEntries(m_node.chainman->m_blockman, *block_index, entries[block_index->nHeight]);
+        outputs += entries[block_index->nHeight].size();
+    }
+    BOOST_CHECK(outputs > 0);
+
+    // Ranges not starting at genesis line up with their heights.
+    BOOST_REQUIRE(viewtagindex.LookUpViewTags(tip->nHeight - 9, tip, entries));
+    BOOST_REQUIRE_EQUAL(entries.size(), 10U);
+    BOOST_CHECK_EQUAL(entries.back().block_hash, tip->GetBlockHash());
+    BOOST_CHECK(!viewtagindex.LookUpViewTags(tip->nHeight + 1, tip, entries));
+
+    // New blocks make it into the index.
+    for (int i = 0; i < 5; i++) {
+        CreateAndProcessBlock({});
+        BOOST_CHECK(viewtagindex.BlockUntilSyncedToCurrentChain());
+
+        const CBlockIndex* new_tip = WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain().Tip());
+        BOOST_REQUIRE(viewtagindex.LookUpViewTags(new_tip->nHeight, new_tip, entries));
+        BOOST_REQUIRE_EQUAL(entries.size(), 1U);
+        CheckEntries(m_node.chainman->m_blockman, *new_tip, entries[0]);
+    }
+
+    // The stored hashes are checked against the requested chain, so a block
+    // the index has never seen at an indexed height is not served.
+    CBlockIndex fake_index;
+    const uint256 fake_hash{uint256::ONE};
+    fake_index.phashBlock = &fake_hash;
+    fake_index.nHeight = tip->nHeight;
+    fake_index.pprev = tip->pprev;
+    BOOST_CHECK(!viewtagindex.LookUpViewTags(tip->nHeight, &fake_index, entries));
+
+    SyncWithValidationInterfaceQueue();
+    viewtagindex.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
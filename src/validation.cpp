@@ -63,12 +63,16 @@
 #include <warnings.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <deque>
+#include <future>
 #include <numeric>
 #include <optional>
+#include <set>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -83,6 +87,8 @@ using node::BlockMap;
 using node::CBlockIndexHeightOnlyComparator;
 using node::CBlockIndexWorkComparator;
 using node::fReindex;
+using node::MAX_SNAPSHOT_THREADS;
+using node::SnapshotChunk;
 using node::SnapshotMetadata;
 
 /** Time to wait between writing blocks/block index to disk. */
@@ -2184,35 +2190,38 @@ static SteadyClock::duration time_index{};
 static SteadyClock::duration time_total{};
 static int64_t num_blocks_total = 0;
 
+/** A candidate block for the stake modifier selection, with its selection
+ *  hash computed once for all the selection rounds. */
+struct StakeModifierCandidate {
+    int64_t nTime;
+    uint256 hash;
+    const CBlockIndex* pindex;
+    uint256 hashSelection;
+
+    bool operator<(const StakeModifierCandidate& other) const
+    {
+        return std::tie(nTime, hash) < std::tie(other.nTime, other.hash);
+    }
+};
+
 // select a block from the candidate blocks in vSortedByTimestamp, excluding
-// already selected blocks in vSelectedBlocks, and with timestamp up to
+// already selected blocks in setSelectedBlocks, and with timestamp up to
 // nSelectionIntervalStop.
-static bool SelectBlockFromCandidates(std::vector<std::pair<int64_t, uint256>>& vSortedByTimestamp, std::map<uint256, const CBlockIndex*>& mapSelectedBlocks,
-                                      int64_t nSelectionIntervalStop, uint64_t nStakeModifierPrev, const CBlockIndex** pindexSelected, const Consensus::Params& params, const node::BlockManager& m_blockman) EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+static bool SelectBlockFromCandidates(const std::vector<StakeModifierCandidate>& vSortedByTimestamp, const std::set<const CBlockIndex*>& setSelectedBlocks,
+                                      int64_t nSelectionIntervalStop, const CBlockIndex** pindexSelected) EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
 {
     AssertLockHeld(::cs_main);
     bool fSelected = false;
     uint256 hashBest = uint256();
     *pindexSelected = (const CBlockIndex*)nullptr;
-    for (const std::pair<int64_t, uint256>& item : vSortedByTimestamp) {
-        const CBlockIndex* pindex = m_blockman.LookupBlockIndex(item.second);
-        if (!pindex) return false;
-        // error("SelectBlockFromCandidates: failed to find block index for candidate block %s", item.second.ToString());
+    for (const StakeModifierCandidate& item : vSortedByTimestamp) {
+        const CBlockIndex* pindex = item.pindex;
         if (fSelected && pindex->GetBlockTime() > nSelectionIntervalStop) {
-            //            LogPrint("stakemodifier", "SelectBlockFromCandidates: selection hash=%s index=%d proofhash=%s nStakeModifierPrev=%08x\n", hashBest.ToString(), pindex->nHeight, pindex->kernelHash.ToString(), nStakeModifierPrev);
+            //            LogPrint("stakemodifier", "SelectBlockFromCandidates: selection hash=%s index=%d proofhash=%s\n", hashBest.ToString(), pindex->nHeight, pindex->kernelHash.ToString());
             break;
         }
-        if (mapSelectedBlocks.count(pindex->GetBlockHash()) > 0) continue;
-        // compute the selection hash by hashing its proof-hash and the
-        // previous proof-of-stake modifier
-        HashWriter ss{};
-        ss << pindex->kernelHash << nStakeModifierPrev;
-        uint256 hashSelection = ss.GetHash();
-        // the selection hash is divided by 2**32 so that proof-of-stake block
-        // is always favored over proof-of-work block. this is to preserve
-        // the energy efficiency property
-        if (pindex->IsProofOfStake())
-            hashSelection = ArithToUint256(UintToArith256(hashSelection) >> 32);
+        if (setSelectedBlocks.count(pindex) > 0) continue;
+        const uint256& hashSelection = item.hashSelection;
         if (fSelected && hashSelection < hashBest) {
             hashBest = hashSelection;
             *pindexSelected = (const CBlockIndex*)pindex;
@@ -2239,7 +2248,7 @@ static bool SelectBlockFromCandidates(std::vector<std::pair<int64_t, uint256>>&
 // block. This is to make it difficult for an attacker to gain control of
 // additional bits in the stake modifier, even after generating a chain of
 // blocks.
-static bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, uint64_t& nStakeModifier, bool& fGeneratedStakeModifier, const Consensus::Params& params, const node::BlockManager& m_blockman) EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+static bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, uint64_t& nStakeModifier, bool& fGeneratedStakeModifier, const Consensus::Params& params) EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
 {
     AssertLockHeld(::cs_main);
     nStakeModifier = 0;
@@ -2262,7 +2271,7 @@ static bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, uint64_t& nS
     }
 
     // Sort candidate blocks by timestamp
-    std::vector<std::pair<int64_t, uint256>> vSortedByTimestamp;
+    std::vector<StakeModifierCandidate> vSortedByTimestamp;
     vSortedByTimestamp.reserve(64 * params.nModifierInterval / params.nPosTargetSpacing);
     int64_t nSelectionInterval = blsct::GetStakeModifierSelectionInterval(params);
     int64_t nSelectionIntervalStart = (pindexPrev->GetBlockTime() / params.nModifierInterval) * params.nModifierInterval - nSelectionInterval;
@@ -2271,8 +2280,17 @@ static bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, uint64_t& nS
     const CBlockIndex* pindex = pindexPrev;
 
     while (pindex && pindex->GetBlockTime() >= nSelectionIntervalStart) {
-        auto el = std::make_pair(pindex->GetBlockTime(), pindex->GetBlockHash());
-        vSortedByTimestamp.emplace_back(el);
+        // compute the selection hash by hashing its proof-hash and the
+        // previous proof-of-stake modifier
+        HashWriter ss{};
+        ss << pindex->kernelHash << nStakeModifier;
+        uint256 hashSelection = ss.GetHash();
+        // the selection hash is divided by 2**32 so that proof-of-stake block
+        // is always favored over proof-of-work block. this is to preserve
+        // the energy efficiency property
+        if (pindex->IsProofOfStake())
+            hashSelection = ArithToUint256(UintToArith256(hashSelection) >> 32);
+        vSortedByTimestamp.push_back({pindex->GetBlockTime(), pindex->GetBlockHash(), pindex, hashSelection});
         pindex = pindex->pprev;
     }
 
@@ -2283,19 +2301,19 @@ static bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, uint64_t& nS
     // Select 64 blocks from candidate blocks to generate stake modifier
     uint64_t nStakeModifierNew = 0;
     int64_t nSelectionIntervalStop = nSelectionIntervalStart;
-    std::map<uint256, const CBlockIndex*> mapSelectedBlocks;
+    std::set<const CBlockIndex*> setSelectedBlocks;
 
     for (int nRound = 0; nRound < std::min(64, (int)vSortedByTimestamp.size()); nRound++) {
         // add an interval section to the current selection round
         nSelectionIntervalStop += blsct::GetStakeModifierSelectionIntervalSection(nRound, params);
         // select a block from the candidates of current round
-        if (!SelectBlockFromCandidates(vSortedByTimestamp, mapSelectedBlocks, nSelectionIntervalStop, nStakeModifier, &pindex, params, m_blockman))
+        if (!SelectBlockFromCandidates(vSortedByTimestamp, setSelectedBlocks, nSelectionIntervalStop, &pindex))
             return error("%s: unable to select block at round %d", __func__, nRound);
 
         // write the entropy bit of the selected block
         nStakeModifierNew |= (((uint64_t)pindex->GetStakeEntropyBit()) << nRound);
         // add the selected block from candidates to selected list
-        mapSelectedBlocks.insert(std::make_pair(pindex->GetBlockHash(), pindex));
+        setSelectedBlocks.insert(pindex);
         //        LogPrint("stakemodifier", "ComputeNextStakeModifier: selected round %d stop=%s height=%d bit=%d\n", nRound, DateTimeStrFormat("%Y-%m-%d %H:%M:%S", nSelectionIntervalStop), pindex->nHeight, pindex->GetStakeEntropyBit());
     }
 
@@ -2311,10 +2329,10 @@ static bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, uint64_t& nS
                 strSelectionMap.replace(pindex->nHeight - nHeightFirstCandidate, 1, "=");
             pindex = pindex->pprev;
         }
-        for (const std::pair<uint256, const CBlockIndex*>& item : mapSelectedBlocks) {
+        for (const CBlockIndex* item : setSelectedBlocks) {
             // 'S' indicates selected proof-of-stake blocks
             // 'W' indicates selected proof-of-work blocks
-            strSelectionMap.replace(item.second->nHeight - nHeightFirstCandidate, 1, item.second->IsProofOfStake() ? "S" : "W");
+            strSelectionMap.replace(item->nHeight - nHeightFirstCandidate, 1, item->IsProofOfStake() ? "S" : "W");
         }
         //        LogPrintf("ComputeNextStakeModifier: selection height [%d, %d] map %s\n", nHeightFirstCandidate, pindexPrev->nHeight, strSelectionMap);
     }*/
@@ -2354,7 +2372,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     // is enforced in ContextualCheckBlockHeader(); we wouldn't want to
     // re-enforce that rule here (at least until we make it impossible for
     // m_adjusted_time_callback() to go backward).
-    if (!CheckBlock(block, state, params.GetConsensus(), !fJustCheck, !fJustCheck)) {
+    if (!CheckBlock(block, state, params.GetConsensus(), !fJustCheck, !fJustCheck, &m_chainman.GetBLSCTCheckQueue())) {
         if (state.GetResult() == BlockValidationResult::BLOCK_MUTATED) {
             // We don't write down blocks to disk if they may have been
             // corrupted, so this should be impossible unless we're having hardware
@@ -2441,7 +2459,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     uint64_t nStakeModifier = 0;
     bool fGeneratedStakeModifier = false;
-    if (!ComputeNextStakeModifier(pindex->pprev, nStakeModifier, fGeneratedStakeModifier, params.GetConsensus(), m_blockman))
+    if (!ComputeNextStakeModifier(pindex->pprev, nStakeModifier, fGeneratedStakeModifier, params.GetConsensus()))
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-stake-modifier");
 
     pindex->SetStakeModifier(nStakeModifier, fGeneratedStakeModifier);
@@ -3886,7 +3904,7 @@ static bool CheckBlockHeader(const CBlockHeader& block, BlockValidationState& st
     return true;
 }
 
-bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW, bool fCheckMerkleRoot)
+bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW, bool fCheckMerkleRoot, CCheckQueue<CBLSCTCheck>* blsct_check_queue)
 {
     // These are checks that are independent of context.
 
@@ -3927,6 +3945,30 @@ bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensu
     if (block.vtx.empty() || block.vtx.size() * WITNESS_SCALE_FACTOR > MAX_BLOCK_WEIGHT || ::GetSerializeSize(TX_NO_WITNESS(block)) * WITNESS_SCALE_FACTOR > MAX_BLOCK_WEIGHT)
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-blk-length", "size limits failed");
 
+    // Run the subgroup checks of the points which were deferred when the
+    // block was deserialized as one batch, on the worker threads if available.
+    // The points are only needed for this, so they are dropped afterwards.
+    if (!block.vDeferredPoints.empty()) {
+        bool fPointsOk = true;
+        if (blsct_check_queue && blsct_check_queue->HasThreads()) {
+            CCheckQueueControl<CBLSCTCheck> control(blsct_check_queue);
+            std::vector<CBLSCTCheck> vChecks;
+            vChecks.reserve(block.vDeferredPoints.size());
+            for (const auto& point : block.vDeferredPoints) {
+                vChecks.emplace_back(point);
+            }
+            control.Add(std::move(vChecks));
+            fPointsOk = control.Wait();
+        } else {
+            fPointsOk = std::all_of(block.vDeferredPoints.begin(), block.vDeferredPoints.end(),
+                                    [](const MclG1Point& point) { return point.IsValidOrder(); });
+        }
+        block.vDeferredPoints.clear();
+        block.vDeferredPoints.shrink_to_fit();
+        if (!fPointsOk)
+            return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-blsct-point", "point not in the prime order subgroup");
+    }
+
     // First transaction must be coinbase, the rest must not be
     if (block.vtx.empty() || !block.vtx[0]->IsCoinBase())
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-cb-missing", "first tx is not coinbase");
@@ -4380,7 +4422,7 @@ bool ChainstateManager::AcceptBlock(const std::shared_ptr<const CBlock>& pblock,
 
     const CChainParams& params{GetParams()};
 
-    if (!CheckBlock(block, state, params.GetConsensus()) ||
+    if (!CheckBlock(block, state, params.GetConsensus(), /*fCheckPOW=*/true, /*fCheckMerkleRoot=*/true, &m_blsct_check_queue) ||
         !ContextualCheckBlock(block, state, *this, pindex->pprev)) {
         if (state.IsInvalid() && state.GetResult() != BlockValidationResult::BLOCK_MUTATED) {
             pindex->nStatus |= BLOCK_FAILED_VALID;
@@ -4439,7 +4481,7 @@ bool ChainstateManager::ProcessNewBlock(const std::shared_ptr<const CBlock>& blo
         // malleability that cause CheckBlock() to fail; see e.g. CVE-2012-2459 and
         // https://lists.linuxfoundation.org/pipermail/bitcoin-dev/2019-February/016697.html.  Because CheckBlock() is
         // not very expensive, the anti-DoS benefits of caching failure (of a definitely-invalid block) are not substantial.
-        bool ret = CheckBlock(*block, state, GetConsensus());
+        bool ret = CheckBlock(*block, state, GetConsensus(), /*fCheckPOW=*/true, /*fCheckMerkleRoot=*/true, &m_blsct_check_queue);
         if (ret) {
             // Store to disk
             ret = AcceptBlock(block, state, &pindex, force_processing, nullptr, new_block, min_pow_checked);
@@ -4983,7 +5025,11 @@ void ChainstateManager::LoadExternalBlockFile(
                         // This block can be processed immediately; rewind to its start, read and deserialize it.
                         blkdat.SetPos(nBlockPos);
                         pblock = std::make_shared<CBlock>();
-                        blkdat >> TX_WITH_WITNESS(*pblock);
+                        {
+                            MclG1Point::DeferredOrderChecks deferred_checks;
+                            blkdat >> TX_WITH_WITNESS(*pblock);
+                            pblock->vDeferredPoints = std::move(deferred_checks.points);
+                        }
                         nRewind = blkdat.GetPos();
 
                         BlockValidationState state;
@@ -5662,68 +5708,115 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
         return false;
     }
 
-    COutPoint outpoint;
-    Coin coin;
     const uint64_t coins_count = metadata.m_coins_count;
     uint64_t coins_left = metadata.m_coins_count;
+    const auto& staked_commitments = metadata.m_staked_commitments;
 
     LogPrintf("[snapshot] loading coins from snapshot %s\n", base_blockhash.ToString());
     int64_t coins_processed{0};
 
+    // Chunks are read here and handed to worker threads, which check their
+    // checksum, decode their coins and look up the staked ones among the
+    // commitments of the metadata. Decoded chunks are added to the cache in
+    // file order.
+    std::atomic<uint64_t> staked_coins{0};
+    std::atomic<bool> unknown_staked_commitment{false};
+    const auto decode_chunk = [&](const SnapshotChunk& chunk) -> std::optional<std::vector<std::pair<COutPoint, Coin>>> {
+        std::vector<std::pair<COutPoint, Coin>> coins;
+        if (!chunk.GetCoins(coins)) return std::nullopt;
+        for (const auto& [outpoint, coin] : coins) {
+            if (!coin.out.IsStakedCommitment()) continue;
+            if (!staked_commitments.Exists(coin.out.blsctData.rangeProof.Vs[0])) {
+                unknown_staked_commitment = true;
+            }
+            ++staked_coins;
+        }
+        return coins;
+    };
+
+    const size_t max_pending_chunks = std::clamp<int>(std::thread::hardware_concurrency(), 1, MAX_SNAPSHOT_THREADS);
+    std::deque<std::future<std::optional<std::vector<std::pair<COutPoint, Coin>>>>> pending_chunks;
+    uint64_t coins_queued{0};
+    bool end_of_file{false};
+
     while (coins_left > 0) {
-        try {
-            coins_file >> outpoint;
-            coins_file >> coin;
-        } catch (const std::ios_base::failure&) {
+        while (!end_of_file && coins_queued < coins_count && pending_chunks.size() < max_pending_chunks) {
+            SnapshotChunk chunk;
+            try {
+                coins_file >> chunk;
+            } catch (const std::ios_base::failure&) {
+                end_of_file = true;
+                break;
+            }
+            coins_queued += chunk.m_coins_count;
+            pending_chunks.push_back(std::async(std::launch::async, [&decode_chunk, chunk = std::move(chunk)] { return decode_chunk(chunk); }));
+        }
+        if (pending_chunks.empty()) {
             LogPrintf("[snapshot] bad snapshot format or truncated snapshot after deserializing %d coins\n",
                       coins_count - coins_left);
             return false;
         }
-        if (coin.nHeight > base_height ||
-            outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
-        ) {
-            LogPrintf("[snapshot] bad snapshot data after deserializing %d coins\n",
+
+        auto coins{pending_chunks.front().get()};
+        pending_chunks.pop_front();
+        if (!coins) {
+            LogPrintf("[snapshot] bad snapshot chunk after deserializing %d coins\n",
                       coins_count - coins_left);
             return false;
         }
-        if (!MoneyRange(coin.out.nValue)) {
-            LogPrintf("[snapshot] bad snapshot data after deserializing %d coins - bad tx out value\n",
-                      coins_count - coins_left);
+        if (coins->size() > coins_left) {
+            LogPrintf("[snapshot] bad snapshot - coins left over after deserializing %d coins\n",
+                      coins_count);
             return false;
         }
 
-        coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
+        for (auto& [outpoint, coin] : *coins) {
+            if (coin.nHeight > base_height ||
+                outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
+            ) {
+                LogPrintf("[snapshot] bad snapshot data after deserializing %d coins\n",
+                          coins_count - coins_left);
+                return false;
+            }
+            if (!MoneyRange(coin.out.nValue)) {
+                LogPrintf("[snapshot] bad snapshot data after deserializing %d coins - bad tx out value\n",
+                          coins_count - coins_left);
+                return false;
+            }
 
-        --coins_left;
-        ++coins_processed;
+            coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
 
-        if (coins_processed % 1000000 == 0) {
-            LogPrintf("[snapshot] %d coins loaded (%.2f%%, %.2f MB)\n",
-                coins_processed,
-                static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
-                coins_cache.DynamicMemoryUsage() / (1000 * 1000));
-        }
+            --coins_left;
+            ++coins_processed;
 
-        // Batch write and flush (if we need to) every so often.
-        //
-        // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
-        // means <5MB of memory imprecision.
-        if (coins_processed % 120000 == 0) {
-            if (m_interrupt) {
-                return false;
+            if (coins_processed % 1000000 == 0) {
+                LogPrintf("[snapshot] %d coins loaded (%.2f%%, %.2f MB)\n",
+                    coins_processed,
+                    static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
+                    coins_cache.DynamicMemoryUsage() / (1000 * 1000));
             }
 
-            const auto snapshot_cache_state = WITH_LOCK(::cs_main,
-                return snapshot_chainstate.GetCoinsCacheSizeState());
+            // Batch write and flush (if we need to) every so often.
+            //
+            // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
+            // means <5MB of memory imprecision.
+            if (coins_processed % 120000 == 0) {
+                if (m_interrupt) {
+                    return false;
+                }
+
+                const auto snapshot_cache_state = WITH_LOCK(::cs_main,
+                    return snapshot_chainstate.GetCoinsCacheSizeState());
 
-            if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
-                // This is a hack - we don't know what the actual best block is, but that
-                // doesn't matter for the purposes of flushing the cache here. We'll set this
-                // to its correct value (`base_blockhash`) below after the coins are loaded.
-                coins_cache.SetBestBlock(GetRandHash());
+                if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
+                    // This is a hack - we don't know what the actual best block is, but that
+                    // doesn't matter for the purposes of flushing the cache here. We'll set this
+                    // to its correct value (`base_blockhash`) below after the coins are loaded.
+                    coins_cache.SetBestBlock(GetRandHash());
 
-                // No need to acquire cs_main since this chainstate isn't being used yet.
-                FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
+                    // No need to acquire cs_main since this chainstate isn't being used yet.
+                    FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
+                }
             }
         }
     }
@@ -5737,7 +5830,8 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
 
     bool out_of_coins{false};
     try {
-        coins_file >> outpoint;
+        SnapshotChunk chunk;
+        coins_file >> chunk;
     } catch (const std::ios_base::failure&) {
         // We expect an exception since we should be out of coins.
         out_of_coins = true;
@@ -5748,6 +5842,15 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
         return false;
     }
 
+    // The staked commitments are not covered by the assumeutxo hash, so they
+    // must be exactly those of the staked coins, which are.
+    if (unknown_staked_commitment || staked_coins != staked_commitments.Size()) {
+        LogPrintf("[snapshot] bad snapshot - staked commitments do not match the %d staked coins\n",
+            staked_coins.load());
+        return false;
+    }
+    coins_cache.SetStakedCommitmentsInternalDANGER(OrderedElements<MclG1Point>{staked_commitments});
+
     LogPrintf("[snapshot] loaded %d (%.2f MB) coins from snapshot %s\n",
         coins_count,
         coins_cache.DynamicMemoryUsage() / (1000 * 1000),
@@ -6054,6 +6157,7 @@ static ChainstateManager::Options&& Flatten(ChainstateManager::Options&& opts)
 
 ChainstateManager::ChainstateManager(const util::SignalInterrupt& interrupt, Options options, node::BlockManager::Options blockman_options)
     : m_script_check_queue{/*batch_size=*/128, options.worker_threads_num},
+      m_blsct_check_queue{/*batch_size=*/128, options.worker_threads_num},
       m_interrupt{interrupt},
       m_options{Flatten(std::move(options))},
       m_blockman{interrupt, std::move(blockman_options)}
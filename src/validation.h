@@ -366,13 +366,44 @@ public:
 // static_assert(std::is_nothrow_move_constructible_v<CScriptCheck>);
 // static_assert(std::is_nothrow_destructible_v<CScriptCheck>);
 
+/**
+ * Closure representing one of the BLSCT checks which do not depend on the
+ * UTXO set: either the subgroup check of a point whose check was deferred
+ * while deserializing a block (see CBlock::vDeferredPoints), or the range
+ * proof verification of a transaction. Valid range proofs are added to the
+ * range proof cache, so that accepting the transaction later does not verify
+ * them again.
+ * Note that a point check stores a reference to the point.
+ */
+class CBLSCTCheck
+{
+private:
+    const MclG1Point* m_point{nullptr};
+    CTransactionRef m_tx;
+    CAmount m_min_stake{0};
+
+public:
+    explicit CBLSCTCheck(const MclG1Point& point) : m_point(&point) {}
+    CBLSCTCheck(CTransactionRef tx, const CAmount& min_stake) : m_tx(std::move(tx)), m_min_stake(min_stake) {}
+
+    bool operator()()
+    {
+        if (m_point) return m_point->IsValidOrder();
+        TxValidationState state;
+        return blsct::PreVerifyTx(*m_tx, state, m_min_stake);
+    }
+};
+
 /** Initializes the script-execution cache */
 [[nodiscard]] bool InitScriptExecutionCache(size_t max_size_bytes);
 
 /** Functions for validating blocks and updating the block tree */
 
-/** Context-independent validity checks */
-bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, bool fCheckMerkleRoot = true);
+/** Context-independent validity checks
+ *
+ * @param[in]   blsct_check_queue  If not nullptr, the deferred point checks of the block are run on its worker threads
+ */
+bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, bool fCheckMerkleRoot = true, CCheckQueue<CBLSCTCheck>* blsct_check_queue = nullptr);
 
 /** Check a block is completely valid from start to finish (only works on top of our current best block) */
 bool TestBlockValidity(BlockValidationState& state,
@@ -924,6 +955,11 @@ private:
     //! A queue for script verifications that have to be performed by worker threads.
     CCheckQueue<CScriptCheck> m_script_check_queue;
 
+    //! A queue for the BLSCT checks that do not depend on the UTXO set: the
+    //! deferred point checks of incoming blocks and the range proof checks of
+    //! transactions loaded in bulk.
+    CCheckQueue<CBLSCTCheck> m_blsct_check_queue;
+
 public:
     using Options = kernel::ChainstateManagerOpts;
 
@@ -1276,6 +1312,7 @@ public:
     std::optional<int> GetSnapshotBaseHeight() const EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
     CCheckQueue<CScriptCheck>& GetCheckQueue() { return m_script_check_queue; }
+    CCheckQueue<CBLSCTCheck>& GetBLSCTCheckQueue() { return m_blsct_check_queue; }
 
     ~ChainstateManager();
 };
@@ -6,10 +6,12 @@
 #define BITCOIN_WALLET_CONTEXT_H
 
 #include <sync.h>
+#include <util/threadinterrupt.h>
 
 #include <functional>
 #include <list>
 #include <memory>
+#include <thread>
 #include <vector>
 
 class ArgsManager;
@@ -42,6 +44,9 @@ struct WalletContext {
     Mutex wallets_mutex;
     std::vector<std::shared_ptr<CWallet>> wallets GUARDED_BY(wallets_mutex);
     std::list<LoadWalletFn> wallet_load_fns GUARDED_BY(wallets_mutex);
+    //! Thread staking with the wallets named by -stakewallet, and its interrupt
+    std::thread staking_thread;
+    CThreadInterrupt staking_interrupt;
 
     //! Declare default constructor and destructor that are not inline, so code
     //! instantiating the WalletContext struct doesn't need to #include class
@@ -11,6 +11,7 @@
 #include <util/check.h>
 #include <util/fs.h>
 #include <util/string.h>
+#include <util/thread.h>
 #include <util/translation.h>
 #include <wallet/context.h>
 #include <wallet/spend.h>
@@ -20,6 +21,7 @@
 #include <univalue.h>
 
 #include <system_error>
+#include <thread>
 
 namespace wallet {
 bool VerifyWallets(WalletContext& context)
@@ -152,6 +154,15 @@ void StartWallets(WalletContext& context)
         context.scheduler->scheduleEvery([&context] { MaybeCompactWalletDB(context); }, 500ms);
     }
     context.scheduler->scheduleEvery([&context] { MaybeResendWalletTxs(context); }, 1min);
+    // Staking builds proofs and submits blocks, which must not hold up the
+    // scheduler thread the validation callbacks run on
+    if (context.args->IsArgSet("-stakewallet")) {
+        context.staking_thread = std::thread(&util::TraceThread, "stake", [&context] {
+            do {
+                MaybeStakeWallets(context);
+            } while (!context.chain->shutdownRequested() && context.staking_interrupt.sleep_for(1s));
+        });
+    }
 }
 
 void FlushWallets(WalletContext& context)
@@ -163,6 +174,10 @@ void FlushWallets(WalletContext& context)
 
 void StopWallets(WalletContext& context)
 {
+    if (context.staking_thread.joinable()) {
+        context.staking_interrupt();
+        context.staking_thread.join();
+    }
     for (const std::shared_ptr<CWallet>& pwallet : GetWallets(context)) {
         pwallet->Close();
     }
@@ -65,6 +65,7 @@
 #include <wallet/crypter.h>
 #include <wallet/db.h>
 #include <wallet/external_signer_scriptpubkeyman.h>
+#include <wallet/receive.h>
 #include <wallet/scriptpubkeyman.h>
 #include <wallet/transaction.h>
 #include <wallet/types.h>
@@ -1155,16 +1156,13 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
         }
     }
 
-    for (auto& txout : wtx.tx->vout) {
-        if (txout.IsBLSCT()) {
-            auto blsct_man = GetBLSCTKeyMan();
-            if (blsct_man) {
-                auto result = blsct_man->RecoverOutputs({wtx.tx->vout});
-                if (result.is_completed) {
-                    auto xs = result.amounts;
-                    for (auto& res : xs) {
-                        wtx.blsctRecoveryData[res.id] = res;
-                    }
+    if (std::any_of(wtx.tx->vout.begin(), wtx.tx->vout.end(), [](const CTxOut& txout) { return txout.IsBLSCT(); })) {
+        auto blsct_man = GetBLSCTKeyMan();
+        if (blsct_man) {
+            auto result = blsct_man->RecoverOutputs(wtx.tx->vout);
+            if (result.is_completed) {
+                for (auto& res : result.amounts) {
+                    wtx.blsctRecoveryData[res.id] = res;
                 }
             }
         }
@@ -2155,6 +2153,33 @@ void MaybeResendWalletTxs(WalletContext& context)
     }
 }
 
+void MaybeStakeWallets(WalletContext& context)
+{
+    const std::vector<std::string> staking_wallets{context.args->GetArgs("-stakewallet")};
+
+    for (const std::shared_ptr<CWallet>& pwallet : GetWallets(context)) {
+        if (std::find(staking_wallets.begin(), staking_wallets.end(), pwallet->GetName()) == staking_wallets.end()) continue;
+
+        auto blsct_km = pwallet->GetBLSCTKeyMan();
+        if (!blsct_km) continue;
+
+        std::vector<std::pair<MclScalar, MclScalar>> commitments;
+        blsct::SubAddress destination;
+        {
+            LOCK(pwallet->cs_wallet);
+            for (const auto& info : GetStakedCommitmentInfo(*pwallet)) {
+                commitments.emplace_back(info.value, info.gamma);
+            }
+            destination = blsct_km->GetSubAddress();
+        }
+        if (commitments.empty()) continue;
+
+        if (const auto hash{pwallet->chain().stakeBlock(commitments, destination)}) {
+            pwallet->WalletLogPrintf("Staked block %s\n", hash->ToString());
+        }
+    }
+}
+
 
 /** @defgroup Actions
  *
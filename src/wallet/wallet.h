@@ -1084,6 +1084,12 @@ public:
  */
 void MaybeResendWalletTxs(WalletContext& context);
 
+/**
+ * Called periodically by the staking thread when -stakewallet is set. Tries to
+ * stake a block in-process with the staked commitments of each selected wallet.
+ */
+void MaybeStakeWallets(WalletContext& context);
+
 /** RAII object to check and reserve a wallet rescan */
 class WalletRescanReserver
 {
@@ -32,9 +32,15 @@ Interesting starting states could be loading a snapshot when the current chain t
 - TODO: Not an ancestor or a descendant of the snapshot block and has more work
 
 """
+from io import BytesIO
 from shutil import rmtree
 
-from test_framework.messages import tx_from_hex
+from test_framework.messages import (
+    deser_string,
+    hash256,
+    ser_string,
+    tx_from_hex,
+)
 from test_framework.test_framework import BitcoinTestFramework
 from test_framework.util import (
     assert_equal,
@@ -73,29 +79,54 @@ class AssumeutxoTest(BitcoinTestFramework):
             valid_snapshot_contents = f.read()
         bad_snapshot_path = valid_snapshot_path + '.mod'
 
+        # The metadata holds the magic bytes, the version, the base block hash,
+        # the number of coins and the staked commitments (none on regtest). A
+        # single chunk with the coins count, the serialized coins and their
+        # checksum follows.
+        METADATA_SIZE = 5 + 2 + 32 + 8 + 1
+        valid_metadata = valid_snapshot_contents[:METADATA_SIZE]
+        assert_equal(valid_metadata[-1], 0)
+        chunk = BytesIO(valid_snapshot_contents[METADATA_SIZE:])
+        chunk_coins_count = chunk.read(4)
+        valid_coins = deser_string(chunk)
+        assert_equal(chunk.read(32), hash256(chunk_coins_count + ser_string(valid_coins)))
+        assert_equal(chunk.read(), b"")
+
+        def write_snapshot(metadata=valid_metadata, coins=valid_coins, checksum=None):
+            if checksum is None:
+                checksum = hash256(chunk_coins_count + ser_string(coins))
+            with open(bad_snapshot_path, 'wb') as f:
+                f.write(metadata + chunk_coins_count + ser_string(coins) + checksum)
+
         def expected_error(log_msg="", rpc_details=""):
             with self.nodes[1].assert_debug_log([log_msg]):
                 assert_raises_rpc_error(-32603, f"Unable to load UTXO snapshot{rpc_details}", self.nodes[1].loadtxoutset, bad_snapshot_path)
 
+        self.log.info("  - snapshot file with invalid magic bytes or version")
+        write_snapshot(metadata=b"\x00" + valid_metadata[1:])
+        assert_raises_rpc_error(-22, "Unable to parse metadata: Invalid UTXO set snapshot magic bytes", self.nodes[1].loadtxoutset, bad_snapshot_path)
+        write_snapshot(metadata=valid_metadata[:5] + (2).to_bytes(2, "little") + valid_metadata[7:])
+        assert_raises_rpc_error(-22, "Unable to parse metadata: Version of snapshot 2 does not match the supported version 1.", self.nodes[1].loadtxoutset, bad_snapshot_path)
+
         self.log.info("  - snapshot file referring to a block that is not in the assumeutxo parameters")
         prev_block_hash = self.nodes[0].getblockhash(SNAPSHOT_BASE_HEIGHT - 1)
         bogus_block_hash = "0" * 64  # Represents any unknown block hash
         for bad_block_hash in [bogus_block_hash, prev_block_hash]:
-            with open(bad_snapshot_path, 'wb') as f:
-                # block hash of the snapshot base is stored right at the start (first 32 bytes)
-                f.write(bytes.fromhex(bad_block_hash)[::-1] + valid_snapshot_contents[32:])
+            # block hash of the snapshot base is stored right after the magic bytes and version
+            write_snapshot(metadata=valid_metadata[:7] + bytes.fromhex(bad_block_hash)[::-1] + valid_metadata[39:])
             error_details = f", assumeutxo block hash in snapshot metadata not recognized ({bad_block_hash})"
             expected_error(rpc_details=error_details)
 
         self.log.info("  - snapshot file with wrong number of coins")
-        valid_num_coins = int.from_bytes(valid_snapshot_contents[32:32 + 8], "little")
+        valid_num_coins = int.from_bytes(valid_metadata[39:39 + 8], "little")
         for off in [-1, +1]:
-            with open(bad_snapshot_path, 'wb') as f:
-                f.write(valid_snapshot_contents[:32])
-                f.write((valid_num_coins + off).to_bytes(8, "little"))
-                f.write(valid_snapshot_contents[32 + 8:])
+            write_snapshot(metadata=valid_metadata[:39] + (valid_num_coins + off).to_bytes(8, "little") + valid_metadata[47:])
             expected_error(log_msg=f"bad snapshot - coins left over after deserializing 298 coins" if off == -1 else f"bad snapshot format or truncated snapshot after deserializing 299 coins")
 
+        self.log.info("  - snapshot file with a corrupted chunk")
+        write_snapshot(coins=b"\xff" + valid_coins[1:], checksum=hash256(chunk_coins_count + ser_string(valid_coins)))
+        expected_error(log_msg="bad snapshot chunk after deserializing 0 coins")
+
         self.log.info("  - snapshot file with alternated UTXO data")
         cases = [
             [b"\xff" * 32, 0, "05030e506678f2eca8d624ffed97090ab3beadad1b51ee6e5985ba91c5720e37"], # wrong outpoint hash
@@ -105,10 +136,8 @@ class AssumeutxoTest(BitcoinTestFramework):
         ]
 
         for content, offset, wrong_hash in cases:
-            with open(bad_snapshot_path, "wb") as f:
-                f.write(valid_snapshot_contents[:(32 + 8 + offset)])
-                f.write(content)
-                f.write(valid_snapshot_contents[(32 + 8 + offset + len(content)):])
+            # The chunk checksum is updated to match, so only the UTXO set hash can catch these.
+            write_snapshot(coins=valid_coins[:offset] + content + valid_coins[offset + len(content):])
             expected_error(log_msg=f"[snapshot] bad snapshot content hash: expected 61d9c2b29a2571a5fe285fe2d8554f91f93309666fc9b8223ee96338de25ff53, got {wrong_hash}")
 
     def test_invalid_chainstate_scenarios(self):
@@ -258,6 +287,7 @@ class AssumeutxoTest(BitcoinTestFramework):
         # Ensure indexes have synced.
         completed_idx_state = {
             'basic block filter index': COMPLETE_IDX,
+            'blsct block filter index': COMPLETE_IDX,
             'coinstatsindex': COMPLETE_IDX,
         }
         self.wait_until(lambda: n1.getindexinfo() == completed_idx_state)
@@ -306,6 +336,7 @@ class AssumeutxoTest(BitcoinTestFramework):
 
         completed_idx_state = {
             'basic block filter index': COMPLETE_IDX,
+            'blsct block filter index': COMPLETE_IDX,
             'coinstatsindex': COMPLETE_IDX,
             'txindex': COMPLETE_IDX,
         }
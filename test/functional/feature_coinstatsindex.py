@@ -78,8 +78,8 @@ class CoinStatsIndexTest(BitcoinTestFramework):
         self.log.info("Test that gettxoutsetinfo() output is consistent with or without coinstatsindex option")
         res0 = node.gettxoutsetinfo('none')
 
-        # The fields 'disk_size' and 'transactions' do not exist on the index
-        del res0['disk_size'], res0['transactions']
+        # The fields 'disk_size', 'transactions' and 'cache_usage' do not exist on the index
+        del res0['disk_size'], res0['transactions'], res0['cache_usage']
 
         for hash_option in index_hash_options:
             res1 = index_node.gettxoutsetinfo(hash_option)
@@ -250,6 +250,7 @@ class CoinStatsIndexTest(BitcoinTestFramework):
         res = self.nodes[0].gettxoutsetinfo('muhash')
         option_res = self.nodes[1].gettxoutsetinfo(hash_type='muhash', hash_or_height=None, use_index=False)
         del res['disk_size'], option_res['disk_size']
+        del res['cache_usage'], option_res['cache_usage']
         assert_equal(res, option_res)
 
     def _test_reorg_index(self):
@@ -293,11 +294,11 @@ class CoinStatsIndexTest(BitcoinTestFramework):
     def _test_index_rejects_hash_serialized(self):
         self.log.info("Test that the rpc raises if the legacy hash is passed with the index")
 
-        msg = "hash_serialized_3 hash type cannot be queried for a specific block"
-        assert_raises_rpc_error(-8, msg, self.nodes[1].gettxoutsetinfo, hash_type='hash_serialized_3', hash_or_height=111)
+        msg = "hash_serialized_4 hash type cannot be queried for a specific block"
+        assert_raises_rpc_error(-8, msg, self.nodes[1].gettxoutsetinfo, hash_type='hash_serialized_4', hash_or_height=111)
 
         for use_index in {True, False, None}:
-            assert_raises_rpc_error(-8, msg, self.nodes[1].gettxoutsetinfo, hash_type='hash_serialized_3', hash_or_height=111, use_index=use_index)
+            assert_raises_rpc_error(-8, msg, self.nodes[1].gettxoutsetinfo, hash_type='hash_serialized_4', hash_or_height=111, use_index=use_index)
 
     def _test_init_index_after_reorg(self):
         self.log.info("Test a reorg while the index is deactivated")
@@ -8,6 +8,9 @@ from decimal import Decimal
 from enum import Enum
 import http.client
 import json
+import socket
+from threading import Event, Thread
+import time
 import typing
 import urllib.parse
 
@@ -21,6 +24,7 @@ from test_framework.util import (
     assert_equal,
     assert_greater_than,
     assert_greater_than_or_equal,
+    str_to_b64str,
 )
 from test_framework.wallet import (
     MiniWallet,
@@ -51,7 +55,7 @@ def filter_output_indices_by_value(vouts, value):
 class RESTTest (BitcoinTestFramework):
     def set_test_params(self):
         self.num_nodes = 2
-        self.extra_args = [["-rest", "-blockfilterindex=1"], []]
+        self.extra_args = [["-rest", "-blockfilterindex=1", "-viewtagindex"], []]
         # whitelist peers to speed up tx relay / mempool sync
         for args in self.extra_args:
             args.append("-whitelist=noban@127.0.0.1")
@@ -246,6 +250,11 @@ class RESTTest (BitcoinTestFramework):
         response_hex_bytes = response_hex.read().strip(b'\n')
         assert_equal(response_bytes.hex().encode(), response_hex_bytes)
 
+        # The block read for REST is cached and shared with RPC
+        cache_info = self.nodes[0].getblockcacheinfo()
+        assert_equal(self.nodes[0].getblock(bb_hash, 0).encode(), response_hex_bytes)
+        assert_equal(self.nodes[0].getblockcacheinfo()["raw_hits"], cache_info["raw_hits"] + 1)
+
         # Compare with hex block header
         response_header_hex = self.test_rest_request(f"/headers/{bb_hash}", req_type=ReqType.HEX, ret_type=RetType.OBJ, query_params={"count": 1})
         assert_greater_than(int(response_header_hex.getheader('content-length')), BLOCK_HEADER_SIZE*2)
@@ -293,7 +302,7 @@ class RESTTest (BitcoinTestFramework):
         expected_filter = {
             'basic block filter index': {'synced': True, 'best_block_height': 208},
         }
-        self.wait_until(lambda: self.nodes[0].getindexinfo() == expected_filter)
+        self.wait_until(lambda: self.nodes[0].getindexinfo("basic block filter index") == expected_filter)
         json_obj = self.test_rest_request(f"/headers/{bb_hash}", query_params={"count": 5})
         assert_equal(len(json_obj), 5)  # now we should have 5 header objects
         json_obj = self.test_rest_request(f"/blockfilterheaders/basic/{bb_hash}", query_params={"count": 5})
@@ -401,6 +410,32 @@ class RESTTest (BitcoinTestFramework):
         for tx in txs:
             assert tx in json_obj['tx']
 
+        self.log.info("Test that large JSON replies are streamed")
+        # A bulky transaction, mined directly as its padding is not standard,
+        # makes the JSON of its block larger than what the node writes at
+        # once, so the reply uses chunked transfer encoding.
+        bulky_tx = self.wallet.create_self_transfer(target_weight=200_000)
+        bulky_block_hash = self.generateblock(self.nodes[0], output=self.wallet.get_address(), transactions=[bulky_tx['hex']])['hash']
+        self.wallet.rescan_utxos()
+        resp = self.test_rest_request(f"/block/{bulky_block_hash}", ret_type=RetType.OBJ)
+        assert_equal(resp.getheader('Transfer-Encoding'), 'chunked')
+        assert_equal(json.loads(resp.read().decode('utf-8'), parse_float=Decimal), self.nodes[0].getblock(bulky_block_hash, 3))
+        # Small replies are still sent in one piece.
+        resp = self.test_rest_request(f"/block/notxdetails/{bulky_block_hash}", ret_type=RetType.OBJ)
+        assert_equal(resp.getheader('Transfer-Encoding'), None)
+        assert_equal(json.loads(resp.read().decode('utf-8'), parse_float=Decimal), self.nodes[0].getblock(bulky_block_hash, 1))
+
+        self.log.info("Test that large getblock RPC replies are streamed")
+        url = urllib.parse.urlparse(self.nodes[0].url)
+        conn = http.client.HTTPConnection(url.hostname, url.port)
+        headers = {"Authorization": f"Basic {str_to_b64str(f'{url.username}:{url.password}')}"}
+        conn.request('POST', '/', json.dumps({"method": "getblock", "params": [bulky_block_hash, 3], "id": 1}), headers)
+        resp = conn.getresponse()
+        assert_equal(resp.getheader('Transfer-Encoding'), 'chunked')
+        reply = json.loads(resp.read().decode('utf-8'), parse_float=Decimal)
+        assert_equal(reply, {"result": self.nodes[0].getblock(bulky_block_hash, 3), "error": None, "id": 1})
+        conn.close()
+
         self.log.info("Test the /chaininfo URI")
 
         bb_hash = self.nodes[0].getbestblockhash()
@@ -433,5 +468,153 @@ class RESTTest (BitcoinTestFramework):
         resp = self.test_rest_request(f"/deploymentinfo/{INVALID_PARAM}", ret_type=RetType.OBJ, status=400)
         assert_equal(resp.read().decode('utf-8').rstrip(), f"Invalid hash: {INVALID_PARAM}")
 
+        self.log.info("Test the /stakedcommitments URI")
+
+        bb_hash = self.nodes[0].getbestblockhash()
+        json_obj = self.test_rest_request("/stakedcommitments")
+        assert_equal(json_obj, {"snapshot": bb_hash, "base": None, "added": [], "removed": []})
+
+        # A known snapshot is answered with a delta against it
+        json_obj = self.test_rest_request(f"/stakedcommitments/{bb_hash}")
+        assert_equal(json_obj["base"], bb_hash)
+
+        # An unknown snapshot is answered with the full set
+        json_obj = self.test_rest_request(f"/stakedcommitments/{non_existing_blockhash}")
+        assert_equal(json_obj["base"], None)
+
+        # snapshot, base, and empty added and removed vectors
+        bin_resp = self.test_rest_request("/stakedcommitments", req_type=ReqType.BIN, ret_type=RetType.BYTES)
+        assert_equal(bin_resp, bytes.fromhex(bb_hash)[::-1] + bytes(32) + bytes([0, 0]))
+
+        resp = self.test_rest_request(f"/stakedcommitments/{INVALID_PARAM}", ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Invalid URI format. Expected /rest/stakedcommitments[/<snapshot>]")
+
+        self.log.info("Test the /viewtags URI")
+
+        self.wait_until(lambda: self.nodes[0].getindexinfo("viewtagindex")["viewtagindex"]["synced"])
+        tip_height = self.nodes[0].getblockcount()
+        json_obj = self.test_rest_request(f"/viewtags/{tip_height - 4}", query_params={"count": 10})
+        assert_equal(json_obj, self.nodes[0].getviewtags(tip_height - 4, 5))
+        assert_equal([entry["height"] for entry in json_obj], list(range(tip_height - 4, tip_height + 1)))
+        assert_equal(json_obj[-1]["hash"], bb_hash)
+
+        # one block: hash and empty view tag, blinding key, outpoint and spending key columns
+        bin_resp = self.test_rest_request(f"/viewtags/{tip_height}", req_type=ReqType.BIN, ret_type=RetType.BYTES)
+        assert_equal(bin_resp, bytes([1]) + bytes.fromhex(bb_hash)[::-1] + bytes(4))
+
+        resp = self.test_rest_request(f"/viewtags/{tip_height + 1}", ret_type=RetType.OBJ, status=404)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Block height out of range")
+
+        resp = self.test_rest_request(f"/viewtags/{tip_height}", ret_type=RetType.OBJ, status=400, query_params={"count": 0})
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Block count is invalid or out of acceptable range (1-2000): 0")
+
+        self.log.info("Test the /blockrange URI")
+
+        raw_blocks = [bytes.fromhex(self.nodes[0].getblock(self.nodes[0].getblockhash(height), 0)) for height in range(tip_height + 1)]
+        bin_resp = self.test_rest_request(f"/blockrange/{tip_height - 4}/10", req_type=ReqType.BIN, ret_type=RetType.BYTES)
+        assert_equal(bin_resp, b''.join(raw_blocks[-5:]))
+        hex_resp = self.test_rest_request(f"/blockrange/{tip_height - 4}/10", req_type=ReqType.HEX, ret_type=RetType.BYTES)
+        assert_equal(hex_resp.decode('utf-8').rstrip(), b''.join(raw_blocks[-5:]).hex())
+
+        # The whole chain is larger than what the node writes at once
+        resp = self.test_rest_request(f"/blockrange/0/{tip_height + 1}", req_type=ReqType.BIN, ret_type=RetType.OBJ)
+        assert_equal(resp.getheader('Transfer-Encoding'), 'chunked')
+        assert_equal(resp.read(), b''.join(raw_blocks))
+
+        resp = self.test_rest_request(f"/blockrange/{tip_height + 1}/1", req_type=ReqType.BIN, ret_type=RetType.OBJ, status=404)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Block height out of range")
+
+        resp = self.test_rest_request("/blockrange/0/1001", req_type=ReqType.BIN, ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Block count is invalid or out of acceptable range (1-1000): 1001")
+
+        resp = self.test_rest_request("/blockrange/0", req_type=ReqType.BIN, ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Invalid URI format. Expected /rest/blockrange/<start>/<count>")
+
+        resp = self.test_rest_request("/blockrange/0/1", ret_type=RetType.OBJ, status=404)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "output format not found (available: .bin, .hex)")
+
+        self.log.info("Test the /blsctoutputs URI")
+
+        # two blocks: hash and empty outpoint, commitment, spending key,
+        # blinding key, ephemeral key and view tag columns each
+        tip_prev_hash = self.nodes[0].getblockhash(tip_height - 1)
+        bin_resp = self.test_rest_request(f"/blsctoutputs/{tip_height - 1}/5", req_type=ReqType.BIN, ret_type=RetType.BYTES)
+        assert_equal(bin_resp, bytes.fromhex(tip_prev_hash)[::-1] + bytes(6) + bytes.fromhex(bb_hash)[::-1] + bytes(6))
+
+        resp = self.test_rest_request(f"/blsctoutputs/{tip_height + 1}/1", req_type=ReqType.BIN, ret_type=RetType.OBJ, status=404)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Block height out of range")
+
+        resp = self.test_rest_request(f"/blsctoutputs/{INVALID_PARAM}/1", req_type=ReqType.BIN, ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), f"Invalid height: {INVALID_PARAM}")
+
+        self.log.info("Test that expensive requests only take up half of the work queue")
+
+        self.restart_node(0, ["-rest", "-rpcworkqueue=2", "-rpcthreads=1"])
+
+        def send_request(uri):
+            conn = http.client.HTTPConnection(self.url.hostname, self.url.port)
+            with self.nodes[0].wait_for_debug_log([f"Received a GET request for {uri}".encode()]):
+                conn.request('GET', uri)
+            return conn
+
+        # Keep the only worker busy, so that requests stay in the queue
+        with self.nodes[0].wait_for_debug_log([b"method=waitfornewblock"]):
+            blocker = Thread(target=lambda: self.nodes[0].waitfornewblock(timeout=2000))
+            blocker.start()
+        queued_block = send_request(f"/rest/block/{bb_hash}.json")
+        resp = send_request(f"/rest/block/{bb_hash}.json").getresponse()
+        assert_equal(resp.status, 503)
+        assert_equal(resp.read().decode('utf-8'), "Work queue depth exceeded")
+        queued_chaininfo = send_request("/rest/chaininfo.json")
+        assert_equal(queued_block.getresponse().status, 200)
+        assert_equal(queued_chaininfo.getresponse().status, 200)
+        blocker.join()
+
+        self.log.info("Test that a client reading a streamed reply too slowly is dropped")
+
+        self.restart_node(0, ["-rest", "-rpcservertimeout=5"])
+        self.wallet.rescan_utxos()
+        start_height = self.nodes[0].getblockcount() + 1
+        for _ in range(10):
+            bulky_txs = [self.wallet.create_self_transfer(target_weight=250_000)['hex'] for _ in range(15)]
+            self.generateblock(self.nodes[0], output=self.wallet.get_address(), transactions=bulky_txs, sync_fun=self.no_op)
+            self.wallet.rescan_utxos()
+        range_size = sum(2 * self.nodes[0].getblock(self.nodes[0].getblockhash(height), 1)['size'] for height in range(start_height, start_height + 10))
+
+        # The client keeps reading, so the connection never times out, but
+        # too slowly to get the whole range within the timeout.
+        sock = socket.socket()
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 1 << 16)
+        sock.connect((self.url.hostname, self.url.port))
+        received = []
+        stop_reading = Event()
+
+        def read_slowly():
+            while not stop_reading.is_set():
+                received.append(sock.recv(1 << 16))
+                time.sleep(0.05)
+
+        def reply_aborted():
+            # Also keeps the RPC connection from timing out meanwhile
+            self.nodes[0].getblockcount()
+            with open(self.nodes[0].debug_log_path, encoding='utf-8') as dl:
+                return "Aborting reply to" in dl.read()
+
+        reader = Thread(target=read_slowly)
+        sock.sendall(f"GET /rest/blockrange/{start_height}/10.hex HTTP/1.1\r\nHost: {self.url.hostname}\r\n\r\n".encode())
+        reader.start()
+        self.wait_until(reply_aborted)
+        stop_reading.set()
+        reader.join()
+        # The connection is dropped without the end of the chunked body
+        while chunk := sock.recv(1 << 16):
+            received.append(chunk)
+        sock.close()
+        received = b''.join(received)
+        assert received.startswith(b"HTTP/1.1 200 OK")
+        assert_greater_than(range_size, len(received))
+        assert not received.endswith(b"0\r\n\r\n")
+
+
 if __name__ == '__main__':
     RESTTest().main()
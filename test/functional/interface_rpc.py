@@ -48,6 +48,14 @@ class RPCInterfaceTest(BitcoinTestFramework):
         assert_greater_than_or_equal(command['duration'], 0)
         assert_equal(info['logpath'], os.path.join(self.nodes[0].chain_path, 'debug.log'))
 
+        work_queue = info['work_queue']
+        assert_equal(work_queue['depth'], 0)
+        assert_equal(work_queue['max_depth'], 16)
+        assert_equal(work_queue['rejected'], 0)
+        assert_equal([bucket.get('max_us') for bucket in work_queue['wait_histogram']], [100, 1000, 10000, 100000, 1000000, None])
+        # Every request so far, including this one, has been through the queue
+        assert_greater_than_or_equal(sum(bucket['count'] for bucket in work_queue['wait_histogram']), 1)
+
     def test_batch_request(self):
         self.log.info("Testing basic JSON-RPC batch request...")
 
@@ -74,6 +82,27 @@ class RPCInterfaceTest(BitcoinTestFramework):
         assert_equal(result_by_id[3]['error'], None)
         assert result_by_id[3]['result'] is not None
 
+    def test_parallel_batch_request(self):
+        self.log.info("Testing JSON-RPC batch request with calls that run at the same time...")
+
+        node = self.nodes[0]
+        self.generate(node, 20)
+        calls = [{"method": "getblock", "id": height, "params": [node.getblockhash(height)]} for height in range(21)]
+        # A call that changes state splits the batch, the calls around it still run in order
+        calls.insert(10, {"method": "setnetworkactive", "id": "active", "params": [True]})
+        expected = [node.getblock(call["params"][0]) if call["method"] == "getblock" else True for call in calls]
+
+        with node.assert_debug_log(expected_msgs=["[rpcbatch]"]):
+            results = node.batch(calls)
+        assert_equal([res["id"] for res in results], [call["id"] for call in calls])
+        assert_equal([res["error"] for res in results], [None] * len(calls))
+        assert_equal([res["result"] for res in results], expected)
+
+        self.restart_node(0, ["-rpcbatchthreads=0"])
+        with node.assert_debug_log(expected_msgs=[], unexpected_msgs=["[rpcbatch]"]):
+            results = node.batch(calls)
+        assert_equal([res["result"] for res in results], expected)
+
     def test_http_status_codes(self):
         self.log.info("Testing HTTP status codes for JSON-RPC requests...")
 
@@ -91,10 +120,12 @@ class RPCInterfaceTest(BitcoinTestFramework):
             threads.append(t)
         for t in threads:
             t.join()
+        assert_greater_than_or_equal(self.nodes[0].getrpcinfo()['work_queue']['rejected'], 1)
 
     def run_test(self):
         self.test_getrpcinfo()
         self.test_batch_request()
+        self.test_parallel_batch_request()
         self.test_http_status_codes()
         self.test_work_queue_exceeded()
 
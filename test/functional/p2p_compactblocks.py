@@ -183,7 +183,8 @@ class CompactBlocksTest(BitcoinTestFramework):
     # Test "sendcmpct" (between peers preferring the same version):
     # - No compact block announcements unless sendcmpct is sent.
     # - If sendcmpct is sent with version = 1, the message is ignored.
-    # - If sendcmpct is sent with version > 2, the message is ignored.
+    # - If sendcmpct is sent with version 3, only the BLSCT encoding is negotiated.
+    # - If sendcmpct is sent with version > 3, the message is ignored.
     # - If sendcmpct is sent with boolean 0, then block announcements are not
     #   made with compact blocks.
     # - If sendcmpct is then sent with boolean 1, then new block announcements
@@ -193,11 +194,13 @@ class CompactBlocksTest(BitcoinTestFramework):
 
         # Make sure we get a SENDCMPCT message from our peer
         def received_sendcmpct():
-            return (len(test_node.last_sendcmpct) > 0)
+            return (len(test_node.last_sendcmpct) > 1)
         test_node.wait_until(received_sendcmpct, timeout=30)
         with p2p_lock:
-            # Check that version 2 is received.
-            assert_equal(test_node.last_sendcmpct[0].version, 2)
+            # Check that the BLSCT version 3 is received, followed by version 2
+            # for peers which don't know it.
+            assert_equal(test_node.last_sendcmpct[0].version, 3)
+            assert_equal(test_node.last_sendcmpct[1].version, 2)
             test_node.last_sendcmpct = []
 
         tip = int(node.getbestblockhash(), 16)
@@ -232,13 +235,21 @@ class CompactBlocksTest(BitcoinTestFramework):
         # Headers sync before next test.
         test_node.request_headers_and_sync(locator=[tip])
 
-        # Now try a SENDCMPCT message with too-high version
+        # Now try a SENDCMPCT message with the BLSCT version, which doesn't
+        # enable compact block announcements on its own
         test_node.send_and_ping(msg_sendcmpct(announce=True, version=3))
         check_announcement_of_new_block(node, test_node, lambda p: "cmpctblock" not in p.last_message)
 
         # Headers sync before next test.
         test_node.request_headers_and_sync(locator=[tip])
 
+        # Now try a SENDCMPCT message with too-high version
+        test_node.send_and_ping(msg_sendcmpct(announce=True, version=4))
+        check_announcement_of_new_block(node, test_node, lambda p: "cmpctblock" not in p.last_message)
+
+        # Headers sync before next test.
+        test_node.request_headers_and_sync(locator=[tip])
+
         # Now try a SENDCMPCT message with valid version, but announce=False
         test_node.send_and_ping(msg_sendcmpct(announce=False, version=2))
         check_announcement_of_new_block(node, test_node, lambda p: "cmpctblock" not in p.last_message)
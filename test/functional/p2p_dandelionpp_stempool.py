@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 The Navio Core developers
+# Distributed under the MIT software license. See the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""
+Test the Dandelion++ stempool
+
+Stempool behavior:
+   Peer: TestNode --> 0
+   Node0 generates Dandelion++ transactions, which enter the stempool.
+   Make sure they leave it when they get mined, and when their embargo
+   ends, and that getmempoolinfo reports the stempool depth.
+"""
+
+import time
+
+from test_framework.p2p import P2PInterface
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal
+from test_framework.wallet import MiniWallet
+
+# Time in the future that tx is 100% fluffed
+MAX_STEM_TIME = 999
+
+
+class DandelionStempoolTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.extra_args = [["-dandelion", "-whitelist=all@127.0.0.1"]]
+
+    def assert_stempool(self, size, vsize):
+        self.nodes[0].syncwithvalidationinterfacequeue()
+        info = self.nodes[0].getmempoolinfo()
+        assert_equal(info["stempoolsize"], size)
+        assert_equal(info["stempoolbytes"], vsize)
+
+    def run_test(self):
+        node = self.nodes[0]
+        wallet = MiniWallet(node)
+
+        self.log.info("Adding P2PInterface")
+        node.add_p2p_connection(P2PInterface())
+
+        self.log.info("Stem transactions are counted in getmempoolinfo")
+        self.assert_stempool(0, 0)
+        tx1 = wallet.send_self_transfer(from_node=node)
+        tx2 = wallet.send_self_transfer(from_node=node)
+        self.assert_stempool(2, tx1["tx"].get_vsize() + tx2["tx"].get_vsize())
+
+        self.log.info("Mined stem transactions leave the stempool")
+        self.generate(node, 1)
+        self.assert_stempool(0, 0)
+
+        self.log.info("Stem transactions leave the stempool when their embargo ends")
+        tx3 = wallet.send_self_transfer(from_node=node)
+        self.assert_stempool(1, tx3["tx"].get_vsize())
+        node.setmocktime(int(time.time() + MAX_STEM_TIME))
+        self.wait_until(lambda: node.getmempoolinfo()["stempoolsize"] == 0)
+        self.assert_stempool(0, 0)
+        assert tx3["txid"] in node.getrawmempool()
+
+
+if __name__ == "__main__":
+    DandelionStempoolTest().main()
@@ -90,6 +90,7 @@ class BlockchainTest(BitcoinTestFramework):
         self._test_stopatheight()
         self._test_waitforblockheight()
         self._test_getblock()
+        self._test_getblockcacheinfo()
         self._test_getdeploymentinfo()
         self._test_y2106()
         assert self.nodes[0].verifychain(4, 0)
@@ -342,7 +343,7 @@ class BlockchainTest(BitcoinTestFramework):
         assert size > 6400
         assert size < 64000
         assert_equal(len(res['bestblock']), 64)
-        assert_equal(len(res['hash_serialized_3']), 64)
+        assert_equal(len(res['hash_serialized_4']), 64)
 
         self.log.info("Test gettxoutsetinfo works for blockchain with just the genesis block")
         b1hash = node.getblockhash(1)
@@ -355,32 +356,33 @@ class BlockchainTest(BitcoinTestFramework):
         assert_equal(res2['txouts'], 0)
         assert_equal(res2['bogosize'], 0),
         assert_equal(res2['bestblock'], node.getblockhash(0))
-        assert_equal(len(res2['hash_serialized_3']), 64)
+        assert_equal(len(res2['hash_serialized_4']), 64)
 
         self.log.info("Test gettxoutsetinfo returns the same result after invalidate/reconsider block")
         node.reconsiderblock(b1hash)
 
         res3 = node.gettxoutsetinfo()
-        # The field 'disk_size' is non-deterministic and can thus not be
-        # compared between res and res3.  Everything else should be the same.
+        # The fields 'disk_size' and 'cache_usage' are non-deterministic and can
+        # thus not be compared between res and res3.  Everything else should be the same.
         del res['disk_size'], res3['disk_size']
+        del res['cache_usage'], res3['cache_usage']
         assert_equal(res, res3)
 
         self.log.info("Test gettxoutsetinfo hash_type option")
-        # Adding hash_type 'hash_serialized_3', which is the default, should
+        # Adding hash_type 'hash_serialized_4', which is the default, should
         # not change the result.
-        res4 = node.gettxoutsetinfo(hash_type='hash_serialized_3')
-        del res4['disk_size']
+        res4 = node.gettxoutsetinfo(hash_type='hash_serialized_4')
+        del res4['disk_size'], res4['cache_usage']
         assert_equal(res, res4)
 
         # hash_type none should not return a UTXO set hash.
         res5 = node.gettxoutsetinfo(hash_type='none')
-        assert 'hash_serialized_3' not in res5
+        assert 'hash_serialized_4' not in res5
 
         # hash_type muhash should return a different UTXO set hash.
         res6 = node.gettxoutsetinfo(hash_type='muhash')
         assert 'muhash' in res6
-        assert res['hash_serialized_3'] != res6['muhash']
+        assert res['hash_serialized_4'] != res6['muhash']
 
         # muhash should not be returned unless requested.
         for r in [res, res2, res3, res4, res5]:
@@ -634,6 +636,37 @@ class BlockchainTest(BitcoinTestFramework):
         assert 'previousblockhash' not in node.getblock(node.getblockhash(0))
         assert 'nextblockhash' not in node.getblock(node.getbestblockhash())
 
+    def _test_getblockcacheinfo(self):
+        self.log.info("Test getblockcacheinfo")
+        node = self.nodes[0]
+        blockhash = node.getblockhash(150)
+
+        before = node.getblockcacheinfo()
+        assert_equal(before["max_usage"], 32 * 1024 * 1024)
+        assert_greater_than_or_equal(before["max_usage"], before["usage"])
+
+        self.log.info("A block read once is served from the cache")
+        block = node.getblock(blockhash, 2)
+        assert_equal(node.getblock(blockhash, 2), block)
+        info = node.getblockcacheinfo()
+        assert_equal(info["entries"], before["entries"] + 1)
+        assert_equal(info["block_misses"], before["block_misses"] + 1)
+        assert_equal(info["block_hits"], before["block_hits"] + 1)
+        assert_greater_than(info["usage"], before["usage"])
+
+        self.log.info("The serialized block is derived from the cached block, then cached as well")
+        hexblock = node.getblock(blockhash, 0)
+        assert_equal(hash256(bytes.fromhex(hexblock[:160]))[::-1].hex(), blockhash)
+        assert_equal(node.getblock(blockhash, 0), hexblock)
+        info = node.getblockcacheinfo()
+        assert_equal(info["entries"], before["entries"] + 1)
+        assert_equal(info["raw_misses"], before["raw_misses"] + 1)
+        assert_equal(info["raw_hits"], before["raw_hits"] + 1)
+
+        hits = info["block_hits"] + info["raw_hits"]
+        lookups = hits + info["block_misses"] + info["raw_misses"]
+        assert abs(float(info["hit_rate"]) - hits / lookups) < 1e-9
+
 
 if __name__ == '__main__':
     BlockchainTest().main()
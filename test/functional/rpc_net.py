@@ -147,6 +147,8 @@ class NetTest(BitcoinTestFramework):
                 "servicesnames": [],
                 "session_id": "",
                 "startingheight": -1,
+                "stem_route": False,
+                "stem_txs_sent": 0,
                 "subver": "",
                 "synced_blocks": -1,
                 "synced_headers": -1,
@@ -396,6 +396,7 @@ BASE_SCRIPTS = [
     'p2p_dandelionpp_loop.py',
     'p2p_dandelionpp_mempool_leak.py',
     'p2p_dandelionpp_probing.py',
+    'p2p_dandelionpp_stempool.py',
     # Don't append tests at the end to avoid merge conflicts
     # Put them in a random line within the section that fits their approximate run-time
 ]